@@ -0,0 +1,180 @@
+#ifndef LONG_ARITHMETIC_LONG_ACCUMULATOR_H_
+#define LONG_ARITHMETIC_LONG_ACCUMULATOR_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "long_integer.h"
+
+namespace LongArithmetic
+{
+    // Sum of many signed integers kept in carry-save form.
+    // Positive and negative terms are added digit by digit without carry propagation
+    // into separate unnormalized parts, carries are propagated only when a part
+    // may overflow and when the value is read
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongAccumulator
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using NumberType = LongNumber<Traits, Base>;
+        using DigitType = typename NumberType::DigitType;
+        using SizeType = typename NumberType::SizeType;
+        using IntType = typename NumberType::IntType;
+
+        LongAccumulator()
+            : positiveBound_(0)
+            , negativeBound_(0)
+        {}
+
+        void Add(const IntegerType& term)
+        {
+            if (!term.IsZero())
+            {
+                AddDigits(term, term.Sign() > 0);
+            }
+        }
+
+        void Subtract(const IntegerType& term)
+        {
+            if (!term.IsZero())
+            {
+                AddDigits(term, term.Sign() < 0);
+            }
+        }
+
+        // Adds product of number and multiplier
+        void AddProduct(const IntegerType& number, const IntegerType& multiplier)
+        {
+            if (!number.IsZero() && !multiplier.IsZero())
+            {
+                AddProductDigits(number, multiplier, number.Sign() == multiplier.Sign());
+            }
+        }
+
+        // Subtracts product of number and multiplier
+        void SubtractProduct(const IntegerType& number, const IntegerType& multiplier)
+        {
+            if (!number.IsZero() && !multiplier.IsZero())
+            {
+                AddProductDigits(number, multiplier, number.Sign() != multiplier.Sign());
+            }
+        }
+
+        // Returns accumulated sum
+        IntegerType Value() const
+        {
+            std::vector<DigitType> positive(positive_), negative(negative_);
+            Carry(positive);
+            Carry(negative);
+            IntegerType result;
+            IntegerType::Subtract(ToInteger(positive), ToInteger(negative), result);
+            return result;
+        }
+
+        void Clear()
+        {
+            positive_.clear();
+            negative_.clear();
+            positiveBound_ = 0;
+            negativeBound_ = 0;
+        }
+
+    private:
+        // Upper bound of digits of parts, which leaves room for carries
+        static constexpr DigitType Limit = std::numeric_limits<DigitType>::max() / 2;
+
+        void AddDigits(const IntegerType& term, bool positive)
+        {
+            std::vector<DigitType>& part = positive ? positive_ : negative_;
+            DigitType& bound = positive ? positiveBound_ : negativeBound_;
+            Reserve(part, bound, Base - 1, term.Length());
+            for (SizeType i = 0; i < term.Length(); ++i)
+            {
+                part[i] += term.GetDigit(i);
+            }
+        }
+
+        void AddProductDigits(const IntegerType& number, const IntegerType& multiplier,
+            bool positive)
+        {
+            SizeType length = std::min(number.Length(), multiplier.Length());
+            // Long products are computed by fast multiplication and added as a term
+            if (NumberType::UsesTransform(number.Length(), multiplier.Length()) ||
+                length > (Limit - Base) / (DigitType(Base - 1) * (Base - 1)))
+            {
+                IntegerType product;
+                IntegerType::Multiply(number, multiplier, product);
+                AddDigits(product, positive);
+                return;
+            }
+            std::vector<DigitType>& part = positive ? positive_ : negative_;
+            DigitType& bound = positive ? positiveBound_ : negativeBound_;
+            Reserve(part, bound, length * DigitType(Base - 1) * (Base - 1),
+                number.Length() + multiplier.Length());
+            for (SizeType i = 0; i < number.Length(); ++i)
+            {
+                DigitType digit = number.GetDigit(i);
+                DigitType* pPart = part.data() + i;
+                for (SizeType j = 0; j < multiplier.Length(); ++j)
+                {
+                    pPart[j] += digit * multiplier.GetDigit(j);
+                }
+            }
+        }
+
+        // Makes room in part for addition of length digits, each of which adds at most
+        // increment to digits of part
+        static void Reserve(std::vector<DigitType>& part, DigitType& bound,
+            DigitType increment, SizeType length)
+        {
+            if (bound > Limit - increment)
+            {
+                Carry(part);
+                bound = Base - 1;
+            }
+            bound += increment;
+            if (part.size() < length)
+            {
+                part.resize(length, 0);
+            }
+        }
+
+        // Propagates carries, so that every digit of part is less than Base
+        static void Carry(std::vector<DigitType>& part)
+        {
+            DigitType carry = 0;
+            for (std::size_t i = 0; i < part.size(); ++i)
+            {
+                DigitType value = part[i] + carry;
+                part[i] = value % Base;
+                carry = value / Base;
+            }
+            for (; carry > 0; carry /= Base)
+            {
+                part.push_back(carry % Base);
+            }
+        }
+
+        // Converts normalized part into integer
+        static IntegerType ToInteger(const std::vector<DigitType>& part)
+        {
+            IntegerType result(0, static_cast<SizeType>(std::max<std::size_t>(part.size(), 1)));
+            for (std::size_t i = 0; i < part.size(); ++i)
+            {
+                result.value_.GetDigit(i) = part[i];
+            }
+            result.value_.Length() = static_cast<SizeType>(std::max<std::size_t>(part.size(), 1));
+            result.value_.Trim();
+            return result;
+        }
+
+        std::vector<DigitType> positive_;
+        std::vector<DigitType> negative_;
+        DigitType positiveBound_;
+        DigitType negativeBound_;
+    };
+};
+
+#endif
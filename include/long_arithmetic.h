@@ -3,13 +3,44 @@
 
 #include "long_number.h"
 #include "long_integer.h"
+#include "long_prepared_divisor.h"
+#include "long_prepared_multiplier.h"
+#include "long_accumulator.h"
+#include "long_residue_system.h"
+#include "long_modular_context.h"
+#include "long_primality.h"
 #include "long_rational.h"
+#include "long_continued_fraction.h"
+#include "long_float.h"
+#include "long_decimal.h"
+#include "long_reduction.h"
+#include "long_matrix.h"
+#include "long_series.h"
+#include "long_parser.h"
+#include "long_disk_number.h"
 
 namespace LongArithmetic
 {
     using Number = LongNumber<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
     using Integer = LongInteger<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
     using Rational = LongRational<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using ContinuedFraction = LongContinuedFraction<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using Float = LongFloat<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using Decimal = LongDecimal<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using PreparedDivisor = LongPreparedDivisor<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using PreparedMultiplier = LongPreparedMultiplier<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using Accumulator = LongAccumulator<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using ResidueSystem = LongResidueSystem<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using ModularContext = LongModularContext<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using Primality = LongPrimality<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using Series = LongSeries<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using Matrix = LongMatrix<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using Parser = LongParser<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using DiskNumber = LongDiskNumber<LongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+
+    using SharedNumber = LongNumber<SharedLongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using SharedInteger = LongInteger<SharedLongArithmeticTraits, DEFAULT_NUMBER_BASE>;
+    using SharedRational = LongRational<SharedLongArithmeticTraits, DEFAULT_NUMBER_BASE>;
 };
 
 #endif
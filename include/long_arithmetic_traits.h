@@ -1,20 +1,106 @@
 #ifndef LONG_ARITHMETIC_LONG_ARITHMETIC_TRAITS_H_
 #define LONG_ARITHMETIC_LONG_ARITHMETIC_TRAITS_H_
 
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+#include "long_thresholds.h"
+
 namespace LongArithmetic
 {
     const unsigned int DECIMAL_BASE = 10;
     const unsigned int DEFAULT_NUMBER_BASE = 100000000;
+    const unsigned int DEFAULT_FLOAT_PRECISION = 4;
+
+    // Returns threshold given by environment variable name if it is set
+    // to a decimal number and value otherwise
+    inline unsigned int TunedThreshold(const char* name, unsigned int value)
+    {
+        const char* text = std::getenv(name);
+        if (text == nullptr || !std::isdigit(static_cast<unsigned char>(*text)))
+        {
+            return value;
+        }
+        char* end = nullptr;
+        unsigned long long threshold = std::strtoull(text, &end, 10);
+        if (*end != '\0' || threshold > std::numeric_limits<unsigned int>::max())
+        {
+            return value;
+        }
+        return static_cast<unsigned int>(threshold);
+    }
+
+    // Thresholds of generated header may be overridden by environment variables,
+    // which are read once on the first use
+    inline unsigned int TransformMultiplyThreshold()
+    {
+        static const unsigned int threshold = TunedThreshold(
+            "LONG_ARITHMETIC_TRANSFORM_MULTIPLY_THRESHOLD", TRANSFORM_MULTIPLY_THRESHOLD);
+        return threshold;
+    }
+
+    inline unsigned int TransformSquareThreshold()
+    {
+        static const unsigned int threshold = TunedThreshold(
+            "LONG_ARITHMETIC_TRANSFORM_SQUARE_THRESHOLD", TRANSFORM_SQUARE_THRESHOLD);
+        return threshold;
+    }
+
+    // Rounding of results which can not be represented exactly
+    enum class RoundingMode
+    {
+        ToNearest, // to nearest, ties to even
+        ToNearestAway, // to nearest, ties away from zero
+        TowardZero,
+        Upward,
+        Downward
+    };
+
+    // Decides whether value truncated towards zero must be increased in magnitude.
+    // halfComparison is the sign of comparison of discarded part with half of unit,
+    // odd tells whether truncated value is odd.
+    inline bool RoundsAwayFromZero(RoundingMode rounding, int sign,
+        int halfComparison, bool exact, bool odd)
+    {
+        switch (rounding)
+        {
+        case RoundingMode::ToNearest:
+            return halfComparison > 0 || (halfComparison == 0 && odd);
+        case RoundingMode::ToNearestAway:
+            return halfComparison >= 0 && !exact;
+        case RoundingMode::TowardZero:
+            return false;
+        case RoundingMode::Upward:
+            return !exact && sign > 0;
+        case RoundingMode::Downward:
+            return !exact && sign < 0;
+        }
+        return false;
+    }
 
     class LongArithmeticTraits
     {
     public:
+        // Digits are kept in memory as StorageType and widened to DigitType in computations
+        using StorageType = std::uint32_t;
         using DigitType = unsigned long long;
         using ValueType = long long;
         using UnsignedValueType = unsigned long long;
+        // Holds product of UnsignedValueType and BaseType
+        using WideValueType = unsigned __int128;
         using SizeType = unsigned int;
         using IntType = long long;
         using BaseType = unsigned int;
+        static const bool CopyOnWrite = false;
+    };
+
+    // Numbers share digits with their copies until modification
+    class SharedLongArithmeticTraits : public LongArithmeticTraits
+    {
+    public:
+        static const bool CopyOnWrite = true;
     };
 };
 
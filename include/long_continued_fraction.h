@@ -0,0 +1,86 @@
+#ifndef LONG_ARITHMETIC_LONG_CONTINUED_FRACTION_H_
+#define LONG_ARITHMETIC_LONG_CONTINUED_FRACTION_H_
+
+#include <stdexcept>
+
+#include "long_rational.h"
+
+namespace LongArithmetic
+{
+    // Expansion of rational number into continued fraction
+    // a0 + 1 / (a1 + 1 / (a2 + ...)), whose partial quotients are produced one by one.
+    // The first quotient is the floor of the number, the rest are positive.
+    // Convergents p_k / q_k = (a_k p_(k-1) + p_(k-2)) / (a_k q_(k-1) + q_(k-2))
+    // are updated together with quotients
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongContinuedFraction
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using RationalType = LongRational<Traits, Base>;
+
+        explicit LongContinuedFraction(const RationalType& rational)
+            : numerator_(rational.Numerator())
+            , denominator_(rational.Denominator())
+            , previousNumerator_(0)
+            , previousDenominator_(1)
+            , convergentNumerator_(1)
+            , convergentDenominator_(0)
+        {}
+
+        // Tells whether all partial quotients were produced
+        bool Done() const
+        {
+            return denominator_.IsZero();
+        }
+
+        // Function writes the next partial quotient into quotient
+        // and advances convergent
+        void Next(IntegerType& quotient)
+        {
+            if (Done())
+            {
+                throw std::out_of_range("Continued fraction is exhausted");
+            }
+            IntegerType remainder;
+            IntegerType::DivMod(numerator_, denominator_, quotient, remainder, RoundingMode::Downward);
+            numerator_.Swap(denominator_);
+            denominator_.Swap(remainder);
+
+            IntegerType::AddMul(quotient, convergentNumerator_, previousNumerator_);
+            IntegerType::AddMul(quotient, convergentDenominator_, previousDenominator_);
+            previousNumerator_.Swap(convergentNumerator_);
+            previousDenominator_.Swap(convergentDenominator_);
+        }
+
+        // Numerator of the last convergent
+        const IntegerType& Numerator() const
+        {
+            return convergentNumerator_;
+        }
+
+        // Denominator of the last convergent
+        const IntegerType& Denominator() const
+        {
+            return convergentDenominator_;
+        }
+
+        // Returns the last convergent, which equals the number when expansion is done.
+        // At least one quotient must be produced
+        RationalType Convergent() const
+        {
+            return RationalType(convergentNumerator_, convergentDenominator_);
+        }
+
+    private:
+        // Complete quotient numerator_ / denominator_ follows produced quotients
+        IntegerType numerator_;
+        IntegerType denominator_;
+        IntegerType previousNumerator_;
+        IntegerType previousDenominator_;
+        IntegerType convergentNumerator_;
+        IntegerType convergentDenominator_;
+    };
+};
+
+#endif
@@ -0,0 +1,357 @@
+#ifndef LONG_ARITHMETIC_LONG_DECIMAL_H_
+#define LONG_ARITHMETIC_LONG_DECIMAL_H_
+
+#include "long_rational.h"
+
+namespace LongArithmetic
+{
+    // Fixed-point decimal numbers unscaled / 10^scale.
+    // Results of operations are rounded to scale and rounding mode of result.
+    // Base must be a power of ten, so rescaling by its powers is a shift of digits.
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongDecimal
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using RationalType = LongRational<Traits, Base>;
+        using NumberType = LongNumber<Traits, Base>;
+        using IntType = typename IntegerType::IntType;
+        using SizeType = typename IntegerType::SizeType;
+        using ValueType = typename IntegerType::ValueType;
+        using DigitType = typename IntegerType::DigitType;
+        using SignType = typename IntegerType::SignType;
+
+        static_assert(NumberType::DecimalLength() > 0,
+            "Decimal numbers require base which is a power of ten");
+
+        LongDecimal()
+            : unscaled_(0)
+            , scale_(0)
+            , rounding_(RoundingMode::ToNearest)
+        {}
+
+        // Creates number unscaled / 10^scale
+        LongDecimal(const IntegerType& unscaled,
+            SizeType scale,
+            RoundingMode rounding = RoundingMode::ToNearest)
+            : unscaled_(unscaled)
+            , scale_(scale)
+            , rounding_(rounding)
+        {}
+
+        LongDecimal(const RationalType& rational,
+            SizeType scale,
+            RoundingMode rounding = RoundingMode::ToNearest)
+            : unscaled_(0)
+            , scale_(scale)
+            , rounding_(rounding)
+        {
+            IntegerType numerator;
+            ScaleUp(rational.Numerator(), scale, numerator);
+            DivideRounded(numerator, rational.Denominator(), *this);
+        }
+
+        LongDecimal(const LongDecimal<Traits, Base>& number)
+            : unscaled_(number.unscaled_)
+            , scale_(number.scale_)
+            , rounding_(number.rounding_)
+        {
+        }
+
+        // Assigns value of number rounded to scale of this
+        LongDecimal<Traits, Base>& operator = (const LongDecimal<Traits, Base>& number)
+        {
+            if (this != std::addressof(number))
+            {
+                Assign(number.unscaled_, number.scale_);
+            }
+            return *this;
+        }
+
+        static int Compare(const LongDecimal<Traits, Base>& lhs,
+            const LongDecimal<Traits, Base>& rhs)
+        {
+            if (lhs.scale_ == rhs.scale_)
+            {
+                return IntegerType::Compare(lhs.unscaled_, rhs.unscaled_);
+            }
+            IntegerType scaled;
+            if (lhs.scale_ < rhs.scale_)
+            {
+                ScaleUp(lhs.unscaled_, rhs.scale_ - lhs.scale_, scaled);
+                return IntegerType::Compare(scaled, rhs.unscaled_);
+            }
+            ScaleUp(rhs.unscaled_, lhs.scale_ - rhs.scale_, scaled);
+            return IntegerType::Compare(lhs.unscaled_, scaled);
+        }
+
+        static void Add(const LongDecimal<Traits, Base>& number,
+            const LongDecimal<Traits, Base>& summand,
+            LongDecimal<Traits, Base>& result)
+        {
+            IntegerType lhs, rhs, sum;
+            SizeType scale = Align(number, summand, lhs, rhs);
+            IntegerType::Add(lhs, rhs, sum);
+            result.Assign(sum, scale);
+        }
+
+        static void Subtract(const LongDecimal<Traits, Base>& number,
+            const LongDecimal<Traits, Base>& subtrahend,
+            LongDecimal<Traits, Base>& result)
+        {
+            IntegerType lhs, rhs, difference;
+            SizeType scale = Align(number, subtrahend, lhs, rhs);
+            IntegerType::Subtract(lhs, rhs, difference);
+            result.Assign(difference, scale);
+        }
+
+        static void Multiply(const LongDecimal<Traits, Base>& number,
+            const LongDecimal<Traits, Base>& multiplier,
+            LongDecimal<Traits, Base>& result)
+        {
+            IntegerType product;
+            IntegerType::Multiply(number.unscaled_, multiplier.unscaled_, product);
+            result.Assign(product, number.scale_ + multiplier.scale_);
+        }
+
+        static void Divide(const LongDecimal<Traits, Base>& number,
+            const LongDecimal<Traits, Base>& divisor,
+            LongDecimal<Traits, Base>& result)
+        {
+            // number / divisor = (number.unscaled_ * 10^(scale + divisor.scale_ - number.scale_)
+            // / divisor.unscaled_) / 10^scale
+            IntegerType dividend, scaledDivisor;
+            IntType shift = IntType(result.scale_) + divisor.scale_ - number.scale_;
+            if (shift >= 0)
+            {
+                ScaleUp(number.unscaled_, static_cast<SizeType>(shift), dividend);
+                scaledDivisor = divisor.unscaled_;
+            }
+            else
+            {
+                dividend = number.unscaled_;
+                ScaleUp(divisor.unscaled_, static_cast<SizeType>(-shift), scaledDivisor);
+            }
+            DivideRounded(dividend, scaledDivisor, result);
+        }
+
+        // Changes scale of number rounding it if scale decreases
+        void Rescale(SizeType scale)
+        {
+            if (scale >= scale_)
+            {
+                ScaleUp(unscaled_, scale - scale_, unscaled_);
+            }
+            else
+            {
+                ScaleDown(unscaled_, scale_ - scale, rounding_, unscaled_);
+            }
+            scale_ = scale;
+        }
+
+        // Returns exact value of number
+        RationalType ToRational() const
+        {
+            IntegerType denominator;
+            ScaleUp(IntegerType(1), scale_, denominator);
+            return RationalType(unscaled_, denominator);
+        }
+
+        // Reads number in format [-]digits[.digits], scale is given by digits after point
+        friend std::istream& operator >> (std::istream& in,
+            LongDecimal<Traits, Base>& number)
+        {
+            std::string buffer;
+            in >> buffer;
+            std::string::size_type point = buffer.find('.');
+            SizeType scale = 0;
+            if (point != std::string::npos)
+            {
+                scale = static_cast<SizeType>(buffer.size() - point - 1);
+                buffer.erase(point, 1);
+            }
+            if (!IntegerType::ParseDecimal(buffer.data(), buffer.data() + buffer.size(),
+                number.unscaled_))
+            {
+                in.setstate(std::ios::failbit);
+                return in;
+            }
+            number.scale_ = scale;
+            return in;
+        }
+
+        // Writes number with exactly scale digits after point
+        friend std::ostream& operator << (std::ostream& out,
+            const LongDecimal<Traits, Base>& number)
+        {
+            std::ostringstream digitStream;
+            digitStream << number.unscaled_;
+            std::string digits = digitStream.str();
+            if (number.unscaled_.Sign() < 0)
+            {
+                digits.erase(0, 1);
+            }
+            if (digits.size() <= number.scale_)
+            {
+                digits.insert(0, number.scale_ + 1 - digits.size(), '0');
+            }
+            if (number.unscaled_.Sign() < 0)
+            {
+                out << '-';
+            }
+            out.write(digits.data(), digits.size() - number.scale_);
+            if (number.scale_ > 0)
+            {
+                out << '.';
+                out.write(digits.data() + digits.size() - number.scale_, number.scale_);
+            }
+            return out;
+        }
+
+        const IntegerType& Unscaled() const
+        {
+            return unscaled_;
+        }
+
+        SizeType Scale() const
+        {
+            return scale_;
+        }
+
+        RoundingMode& Rounding()
+        {
+            return rounding_;
+        }
+
+        RoundingMode Rounding() const
+        {
+            return rounding_;
+        }
+
+        SignType Sign() const
+        {
+            return unscaled_.Sign();
+        }
+
+    private:
+        // Returns 10^digits for digits less than the length of a digit
+        static DigitType DecimalPower(SizeType digits)
+        {
+            DigitType power = 1;
+            for (SizeType i = 0; i < digits; ++i)
+            {
+                power *= DECIMAL_BASE;
+            }
+            return power;
+        }
+
+        // Function writes number * 10^digits into result
+        static void ScaleUp(const IntegerType& number, SizeType digits, IntegerType& result)
+        {
+            SizeType decimalLength = NumberType::DecimalLength();
+            IntegerType::ShiftLeft(number, digits / decimalLength, result);
+            if (digits % decimalLength != 0)
+            {
+                IntegerType::SmallMultiply(result, DecimalPower(digits % decimalLength), result);
+            }
+        }
+
+        // Function writes number / 10^digits rounded according to rounding into result
+        static void ScaleDown(const IntegerType& number, SizeType digits,
+            RoundingMode rounding, IntegerType& result)
+        {
+            SizeType decimalLength = NumberType::DecimalLength();
+            SizeType shift = digits / decimalLength;
+            SizeType rest = digits % decimalLength;
+            SignType sign = number.Sign();
+
+            // Discarded digits below Base^shift
+            DigitType lowerTop = 0;
+            bool belowTopZero = true;
+            for (SizeType i = 0; i < shift && i < number.Length(); ++i)
+            {
+                if (i + 1 == shift)
+                {
+                    lowerTop = number.GetDigit(i);
+                }
+                else
+                {
+                    belowTopZero &= number.GetDigit(i) == 0;
+                }
+            }
+            IntegerType::ShiftRight(number, shift, result);
+
+            int halfComparison;
+            bool exact;
+            if (rest > 0)
+            {
+                DigitType power = DecimalPower(rest);
+                DigitType surplus;
+                IntegerType::SmallDivide(result, power, result, surplus);
+                bool lowerZero = lowerTop == 0 && belowTopZero;
+                halfComparison = 2 * surplus > power ? 1 :
+                    2 * surplus < power ? -1 :
+                    lowerZero ? 0 : 1;
+                exact = surplus == 0 && lowerZero;
+            }
+            else if (shift > 0)
+            {
+                halfComparison = lowerTop > Base / 2 ? 1 :
+                    lowerTop < Base / 2 ? -1 :
+                    belowTopZero ? 0 : 1;
+                exact = lowerTop == 0 && belowTopZero;
+            }
+            else
+            {
+                return;
+            }
+            if (RoundsAwayFromZero(rounding, sign, halfComparison, exact,
+                result.GetDigit(0) % 2 != 0))
+            {
+                IntegerType::Add(result, IntegerType(ValueType(sign)), result);
+            }
+        }
+
+        // Assigns unscaled / 10^scale rounded to scale of this
+        void Assign(const IntegerType& unscaled, SizeType scale)
+        {
+            if (scale <= scale_)
+            {
+                ScaleUp(unscaled, scale_ - scale, unscaled_);
+            }
+            else
+            {
+                ScaleDown(unscaled, scale - scale_, rounding_, unscaled_);
+            }
+        }
+
+        // Brings unscaled values of numbers to common scale which is returned
+        static SizeType Align(const LongDecimal<Traits, Base>& number,
+            const LongDecimal<Traits, Base>& other,
+            IntegerType& numberUnscaled,
+            IntegerType& otherUnscaled)
+        {
+            SizeType scale = std::max(number.scale_, other.scale_);
+            ScaleUp(number.unscaled_, scale - number.scale_, numberUnscaled);
+            ScaleUp(other.unscaled_, scale - other.scale_, otherUnscaled);
+            return scale;
+        }
+
+        // Writes dividend / divisor rounded to integer as unscaled value of result
+        static void DivideRounded(const IntegerType& dividend,
+            const IntegerType& divisor,
+            LongDecimal<Traits, Base>& result)
+        {
+            IntegerType quotient, surplus;
+            IntegerType::DivMod(dividend, divisor, quotient, surplus, result.rounding_);
+            result.unscaled_.Swap(quotient);
+        }
+
+    private:
+        IntegerType unscaled_;
+        SizeType scale_;
+        RoundingMode rounding_;
+    };
+};
+
+#endif
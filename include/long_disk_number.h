@@ -0,0 +1,443 @@
+#ifndef LONG_ARITHMETIC_LONG_DISK_NUMBER_H_
+#define LONG_ARITHMETIC_LONG_DISK_NUMBER_H_
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "long_integer.h"
+#include "long_transform.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+
+namespace LongArithmetic
+{
+    // Natural numbers whose digits are stored in mapped files, so that their size
+    // is limited by disk instead of memory. Digits are stored from the lowest one.
+    // Arithmetic streams digits through memory: addition is a single pass
+    // over digits, multiplication is a transform, whose values are kept in files
+    // and are processed by a few passes over them
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongDiskNumber
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using NumberType = LongNumber<Traits, Base>;
+        using DigitType = typename NumberType::DigitType;
+        using UnsignedValueType = typename NumberType::UnsignedValueType;
+        using StorageType = typename NumberType::StorageType;
+        using SizeType = typename NumberType::SizeType;
+        using TransformType = typename NumberType::TransformType;
+
+        // Number of transform values of 8 bytes every thread of multiplication
+        // keeps in memory
+        static const SizeType DefaultBlockLength = 1 << 22;
+
+        // Creates file-backed number equal to zero with room for capacity digits
+        LongDiskNumber(const std::string& path, SizeType capacity)
+            : path_(path)
+            , file_(path, std::max<SizeType>(capacity, 1) * sizeof(StorageType))
+            , length_(1)
+        {}
+
+        // Maps existing file of digits for reading and writing
+        explicit LongDiskNumber(const std::string& path)
+            : path_(path)
+            , file_(path, MappedFile::Access::ReadWrite)
+            , length_(0)
+        {
+            if (file_.Size() == 0 || file_.Size() % sizeof(StorageType) != 0)
+            {
+                throw std::invalid_argument("Size of file " + path + " is not a number of digits");
+            }
+            Trim(Capacity());
+        }
+
+        // Creates file with digits of non-negative number
+        LongDiskNumber(const std::string& path, const IntegerType& number)
+            : path_(path)
+            , file_(path, number.value_.Length() * sizeof(StorageType))
+            , length_(number.value_.Length())
+        {
+            if (number.sign_ < 0)
+            {
+                throw std::domain_error("Disk numbers are non-negative");
+            }
+            StorageType* digits = Digits();
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                digits[i] = static_cast<StorageType>(number.value_.GetDigit(i));
+            }
+        }
+
+        LongDiskNumber(const LongDiskNumber&) = delete;
+        LongDiskNumber& operator = (const LongDiskNumber&) = delete;
+
+        SizeType Length() const
+        {
+            return length_;
+        }
+
+        // Number of digits the file holds
+        SizeType Capacity() const
+        {
+            return static_cast<SizeType>(file_.Size() / sizeof(StorageType));
+        }
+
+        DigitType GetDigit(SizeType i) const
+        {
+            return Digits()[i];
+        }
+
+        // Function writes number into result, which must fit in memory
+        void ToInteger(IntegerType& result) const
+        {
+            result = IntegerType(0, length_);
+            const StorageType* digits = Digits();
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                result.value_.GetDigit(i) = digits[i];
+            }
+            result.value_.Length() = length_;
+            result.value_.Trim();
+            result.TestZeroSign();
+        }
+
+        // Function writes sum of lhs and rhs into result, which may be one of them.
+        // Capacity of result must exceed lengths of both numbers
+        static void Add(const LongDiskNumber& lhs, const LongDiskNumber& rhs,
+            LongDiskNumber& result)
+        {
+            SizeType length = std::max(lhs.length_, rhs.length_);
+            Reserve(result, length + 1);
+            // Digits are read and written once in order
+            lhs.file_.Advise(0, lhs.file_.Size(), MADV_SEQUENTIAL);
+            rhs.file_.Advise(0, rhs.file_.Size(), MADV_SEQUENTIAL);
+            result.file_.Advise(0, result.file_.Size(), MADV_SEQUENTIAL);
+            const StorageType* pLeft = lhs.Digits();
+            const StorageType* pRight = rhs.Digits();
+            StorageType* pResult = result.Digits();
+            DigitType carry = 0;
+            for (SizeType i = 0; i < length; ++i)
+            {
+                carry += (i < lhs.length_ ? pLeft[i] : 0) + (i < rhs.length_ ? pRight[i] : 0);
+                pResult[i] = static_cast<StorageType>(carry % Base);
+                carry /= Base;
+            }
+            pResult[length] = static_cast<StorageType>(carry);
+            result.Trim(length + 1);
+        }
+
+        // Function writes product of lhs and rhs into result, which must differ
+        // from both of them. Capacity of result must suffice for the sum of lengths.
+        // Product is computed by transform of halves of digits, whose values are
+        // kept in spill files next to result. Values are viewed as a matrix with rows
+        // of at most blockLength values, stripes of columns hold at most blockLength
+        // values too unless columns are longer. Matrix is transformed by the
+        // four-step method in four passes over files:
+        // columns of operands are transformed by stripes of adjacent columns,
+        // rows are transformed, multiplied and inverted at once,
+        // columns are inverted by stripes,
+        // values are carried into digits of result in order.
+        // Rows and stripes are shared between threads of pool
+        static void Multiply(const LongDiskNumber& lhs, const LongDiskNumber& rhs,
+            LongDiskNumber& result,
+            SizeType blockLength = DefaultBlockLength,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            if (NumberType::HalfBase() == 0)
+            {
+                throw std::invalid_argument("Base of disk numbers must be a square");
+            }
+            if (&result == &lhs || &result == &rhs)
+            {
+                throw std::invalid_argument("Product can not be written over operand");
+            }
+            std::size_t length = std::size_t(lhs.length_) + rhs.length_;
+            Reserve(result, length);
+            if (!NumberType::TransformApplies(lhs.length_, rhs.length_))
+            {
+                throw std::invalid_argument("Operands are too long for transform");
+            }
+
+            std::size_t size = 1;
+            while (size < 2 * length)
+            {
+                size <<= 1;
+            }
+            // Square matrix keeps both columns and rows short enough for cache
+            SizeType columns = 1;
+            while (std::size_t(columns) * columns < size && 2 * columns <= blockLength)
+            {
+                columns <<= 1;
+            }
+            SizeType rows = static_cast<SizeType>(size / columns);
+            SizeType width = 1;
+            while (width < columns && std::size_t(2 * width) * rows <= blockLength)
+            {
+                width <<= 1;
+            }
+
+            // Spill files are removed once mapped and vanish with their mappings
+            bool square = &lhs == &rhs;
+            std::string lhsPath = result.path_ + ".lhs", rhsPath = result.path_ + ".rhs";
+            MappedFile lhsValues(lhsPath, size * sizeof(UnsignedValueType));
+            std::remove(lhsPath.c_str());
+            MappedFile rhsValues(rhsPath, square ? 0 : size * sizeof(UnsignedValueType));
+            std::remove(rhsPath.c_str());
+
+            lhs.TransformColumns(lhsValues, rows, columns, width, pool);
+            if (!square)
+            {
+                rhs.TransformColumns(rhsValues, rows, columns, width, pool);
+            }
+            MultiplyRows(lhsValues, square ? lhsValues : rhsValues, rows, columns, pool);
+            InverseColumns(lhsValues, rows, columns, width, pool);
+            result.Carry(lhsValues, length, columns);
+        }
+
+    private:
+        const StorageType* Digits() const
+        {
+            return reinterpret_cast<const StorageType*>(file_.Data());
+        }
+
+        StorageType* Digits()
+        {
+            return reinterpret_cast<StorageType*>(file_.Data());
+        }
+
+        // Sets length to the number of significant digits among the first length,
+        // digits of the previous value beyond them are cleared, so that the file
+        // holds no stale digits
+        void Trim(SizeType length)
+        {
+            StorageType* digits = Digits();
+            if (length < length_)
+            {
+                std::fill(digits + length, digits + length_, 0);
+            }
+            while (length > 1 && digits[length - 1] == 0)
+            {
+                --length;
+            }
+            length_ = length;
+        }
+
+        // Checks that result can hold length digits
+        static void Reserve(const LongDiskNumber& result, SizeType length)
+        {
+            if (!result.file_.Writable() || result.Capacity() < length)
+            {
+                throw std::invalid_argument("Result can not hold " +
+                    std::to_string(length) + " digits");
+            }
+        }
+
+        // Matrix of transform values stored in file by rows
+        static UnsignedValueType* Values(MappedFile& values)
+        {
+            return reinterpret_cast<UnsignedValueType*>(values.Data());
+        }
+
+        // Advises to read segments of the given number of bytes, which start
+        // at offsets first + i * stride for i < count, before they are used
+        static void Prefetch(const MappedFile& file, std::size_t first, std::size_t bytes,
+            std::size_t stride, SizeType count)
+        {
+            for (SizeType i = 0; i < count; ++i)
+            {
+                file.Advise(first + i * stride, bytes, MADV_WILLNEED);
+            }
+        }
+
+        // Calls load(first, stripe) for stripes of width columns starting at first,
+        // where stripe holds segments of rows one after another, transforms
+        // columns of stripes forward or inverse and writes them to values.
+        // Threads take every groups-th stripe and prefetch their next stripes
+        template <typename Load, typename Next>
+        static void TransformStripes(MappedFile& values, SizeType rows, SizeType columns,
+            SizeType width, bool inverse, ThreadPool& pool, const Load& load, const Next& next)
+        {
+            // Stripes touch every row, so readahead must not assume sequential access
+            values.Advise(0, values.Size(), MADV_NORMAL);
+            UnsignedValueType* pValues = Values(values);
+            SizeType stripes = columns / width;
+            SizeType groups = std::min<SizeType>(stripes, pool.Size() + 1);
+            pool.ParallelFor(groups, [&](std::size_t group)
+            {
+                TransformType stripe(std::size_t(rows) * width), column(rows);
+                for (SizeType index = static_cast<SizeType>(group); index < stripes;
+                    index += groups)
+                {
+                    SizeType first = index * width;
+                    if (index + groups < stripes)
+                    {
+                        next((index + groups) * width);
+                    }
+                    load(first, stripe);
+                    for (SizeType j = 0; j < width; ++j)
+                    {
+                        for (SizeType i = 0; i < rows; ++i)
+                        {
+                            column[i] = stripe[std::size_t(i) * width + j];
+                        }
+                        if (inverse)
+                        {
+                            LongTransform<Traits>::Inverse(column, 0);
+                        }
+                        else
+                        {
+                            LongTransform<Traits>::Forward(column);
+                        }
+                        for (SizeType i = 0; i < rows; ++i)
+                        {
+                            stripe[std::size_t(i) * width + j] = column[i];
+                        }
+                    }
+                    for (SizeType i = 0; i < rows; ++i)
+                    {
+                        std::copy(stripe.begin() + std::size_t(i) * width,
+                            stripe.begin() + std::size_t(i + 1) * width,
+                            pValues + std::size_t(i) * columns + first);
+                    }
+                }
+            });
+        }
+
+        // Function writes halves of digits transformed along columns into values
+        void TransformColumns(MappedFile& values, SizeType rows, SizeType columns,
+            SizeType width, ThreadPool& pool) const
+        {
+            constexpr DigitType halfBase = NumberType::HalfBase();
+            const StorageType* digits = Digits();
+            std::size_t halfLength = 2 * std::size_t(length_);
+            file_.Advise(0, file_.Size(), MADV_NORMAL);
+            auto load = [&](SizeType first, TransformType& stripe)
+            {
+                for (SizeType i = 0; i < rows; ++i)
+                {
+                    std::size_t start = std::size_t(i) * columns + first;
+                    for (SizeType j = 0; j < width; ++j)
+                    {
+                        std::size_t half = start + j;
+                        stripe[std::size_t(i) * width + j] = half >= halfLength ? 0 :
+                            half % 2 == 0 ? digits[half / 2] % halfBase : digits[half / 2] / halfBase;
+                    }
+                }
+            };
+            auto next = [&](SizeType first)
+            {
+                Prefetch(file_, first / 2 * sizeof(StorageType),
+                    (width / 2 + 1) * sizeof(StorageType),
+                    std::size_t(columns) / 2 * sizeof(StorageType),
+                    std::min<SizeType>(rows, static_cast<SizeType>(halfLength / columns + 1)));
+            };
+            TransformStripes(values, rows, columns, width, false, pool, load, next);
+        }
+
+        // Inverts transform of values along columns
+        static void InverseColumns(MappedFile& values, SizeType rows, SizeType columns,
+            SizeType width, ThreadPool& pool)
+        {
+            const UnsignedValueType* pValues = Values(values);
+            auto load = [&](SizeType first, TransformType& stripe)
+            {
+                for (SizeType i = 0; i < rows; ++i)
+                {
+                    const UnsignedValueType* row = pValues + std::size_t(i) * columns + first;
+                    std::copy(row, row + width, stripe.begin() + std::size_t(i) * width);
+                }
+            };
+            auto next = [&](SizeType first)
+            {
+                Prefetch(values, first * sizeof(UnsignedValueType),
+                    width * sizeof(UnsignedValueType),
+                    std::size_t(columns) * sizeof(UnsignedValueType), rows);
+            };
+            TransformStripes(values, rows, columns, width, true, pool, load, next);
+        }
+
+        // Completes transforms of lhs and rhs by rows, multiplies them
+        // and inverts transform of product by rows into lhs
+        static void MultiplyRows(MappedFile& lhs, MappedFile& rhs, SizeType rows,
+            SizeType columns, ThreadPool& pool)
+        {
+            bool square = &lhs == &rhs;
+            std::size_t rowBytes = std::size_t(columns) * sizeof(UnsignedValueType);
+            lhs.Advise(0, lhs.Size(), MADV_SEQUENTIAL);
+            rhs.Advise(0, rhs.Size(), MADV_SEQUENTIAL);
+            UnsignedValueType* pLeft = Values(lhs);
+            const UnsignedValueType* pRight = Values(rhs);
+            SizeType groups = std::min<SizeType>(rows, pool.Size() + 1);
+            pool.ParallelFor(groups, [&](std::size_t group)
+            {
+                TransformType row(columns), other(columns);
+                for (SizeType i = static_cast<SizeType>(group); i < rows; i += groups)
+                {
+                    if (i + groups < rows)
+                    {
+                        lhs.Advise((i + groups) * rowBytes, rowBytes, MADV_WILLNEED);
+                        rhs.Advise((i + groups) * rowBytes, rowBytes, MADV_WILLNEED);
+                    }
+                    UnsignedValueType* left = pLeft + std::size_t(i) * columns;
+                    std::copy(left, left + columns, row.begin());
+                    LongTransform<Traits>::Twist(row, i, rows, false);
+                    LongTransform<Traits>::Forward(row);
+                    if (square)
+                    {
+                        LongTransform<Traits>::PointwiseMultiply(row, row);
+                    }
+                    else
+                    {
+                        const UnsignedValueType* right = pRight + std::size_t(i) * columns;
+                        std::copy(right, right + columns, other.begin());
+                        LongTransform<Traits>::Twist(other, i, rows, false);
+                        LongTransform<Traits>::Forward(other);
+                        LongTransform<Traits>::PointwiseMultiply(row, other);
+                    }
+                    LongTransform<Traits>::Inverse(row, 1);
+                    LongTransform<Traits>::Twist(row, i, rows, true);
+                    std::copy(row.begin(), row.end(), left);
+                }
+            });
+        }
+
+        // Function carries halves of digits given by values into the first length
+        // digits, values are read by rows of given length
+        void Carry(MappedFile& values, std::size_t length, SizeType columns)
+        {
+            constexpr DigitType halfBase = NumberType::HalfBase();
+            const UnsignedValueType* pValues = Values(values);
+            std::size_t rowBytes = std::size_t(columns) * sizeof(UnsignedValueType);
+            values.Advise(0, values.Size(), MADV_SEQUENTIAL);
+            file_.Advise(0, file_.Size(), MADV_SEQUENTIAL);
+            StorageType* digits = Digits();
+            UnsignedValueType carry = 0;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                if (2 * i % columns == 0)
+                {
+                    values.Advise(2 * i * sizeof(UnsignedValueType) + rowBytes, rowBytes,
+                        MADV_WILLNEED);
+                }
+                carry += pValues[2 * i];
+                DigitType low = carry % halfBase;
+                carry = carry / halfBase + pValues[2 * i + 1];
+                DigitType high = carry % halfBase;
+                carry /= halfBase;
+                digits[i] = static_cast<StorageType>(high * halfBase + low);
+            }
+            Trim(static_cast<SizeType>(length));
+        }
+
+    private:
+        std::string path_;
+        MappedFile file_;
+        SizeType length_;
+    };
+};
+
+#endif
@@ -0,0 +1,311 @@
+#ifndef LONG_ARITHMETIC_LONG_EXPRESSION_H_
+#define LONG_ARITHMETIC_LONG_EXPRESSION_H_
+
+#include <memory>
+#include <type_traits>
+
+namespace LongArithmetic
+{
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongInteger;
+
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongRational;
+
+    template <typename Operation, typename Left, typename Right>
+    class LongExpression;
+
+    // Describes types which can be operands of arithmetic operators.
+    // Fused tells whether values have AddMul and SubMul
+    template <typename Type>
+    struct LongOperand
+    {
+        using ValueType = void;
+        static const bool IsValue = false;
+        static const bool IsExpression = false;
+        static const bool Fused = false;
+    };
+
+    template <typename Traits, typename Traits::BaseType Base>
+    struct LongOperand<LongInteger<Traits, Base>>
+    {
+        using ValueType = LongInteger<Traits, Base>;
+        static const bool IsValue = true;
+        static const bool IsExpression = false;
+        static const bool Fused = true;
+    };
+
+    template <typename Traits, typename Traits::BaseType Base>
+    struct LongOperand<LongRational<Traits, Base>>
+    {
+        using ValueType = LongRational<Traits, Base>;
+        static const bool IsValue = true;
+        static const bool IsExpression = false;
+        static const bool Fused = false;
+    };
+
+    template <typename Operation, typename Left, typename Right>
+    struct LongOperand<LongExpression<Operation, Left, Right>>
+    {
+        using ValueType = typename LongOperand<Left>::ValueType;
+        static const bool IsValue = false;
+        static const bool IsExpression = true;
+        static const bool Fused = LongOperand<ValueType>::Fused;
+    };
+
+    struct AddOperation
+    {
+        template <typename Value>
+        static void Apply(const Value& lhs, const Value& rhs, Value& result)
+        {
+            Value::Add(lhs, rhs, result);
+        }
+    };
+
+    struct SubtractOperation
+    {
+        template <typename Value>
+        static void Apply(const Value& lhs, const Value& rhs, Value& result)
+        {
+            Value::Subtract(lhs, rhs, result);
+        }
+    };
+
+    struct MultiplyOperation
+    {
+        template <typename Value>
+        static void Apply(const Value& lhs, const Value& rhs, Value& result)
+        {
+            Value::Multiply(lhs, rhs, result);
+        }
+    };
+
+    struct DivideOperation
+    {
+        template <typename Value>
+        static void Apply(const Value& lhs, const Value& rhs, Value& result)
+        {
+            Value::Divide(lhs, rhs, result);
+        }
+    };
+
+    struct ModOperation
+    {
+        template <typename Value>
+        static void Apply(const Value& lhs, const Value& rhs, Value& result)
+        {
+            Value::Mod(lhs, rhs, result);
+        }
+    };
+
+    // Unevaluated result of operation applied to left and right operands.
+    // Values are held by reference, so expressions must be evaluated within
+    // the full expression which creates them, by assignment or construction
+    // of a value. Evaluation writes into the buffer of the assigned value and
+    // uses fused kernels for sums of products, operands aliased with the
+    // assigned value are evaluated into temporaries first
+    template <typename Operation, typename Left, typename Right>
+    class LongExpression
+    {
+    public:
+        using ValueType = typename LongOperand<Left>::ValueType;
+
+        LongExpression(const Left& left, const Right& right)
+            : left_(left)
+            , right_(right)
+        {}
+
+        const Left& LeftOperand() const
+        {
+            return left_;
+        }
+
+        const Right& RightOperand() const
+        {
+            return right_;
+        }
+
+        // Tells whether value is used by expression
+        bool References(const ValueType& value) const
+        {
+            return Refers(left_, value) || Refers(right_, value);
+        }
+
+        void EvaluateInto(ValueType& result) const
+        {
+            const bool isSum = std::is_same<Operation, AddOperation>::value;
+            const bool isDifference = std::is_same<Operation, SubtractOperation>::value;
+            const bool isCommutative = isSum || std::is_same<Operation, MultiplyOperation>::value;
+
+            // result = left + a * b and result = left - a * b
+            if constexpr (LongOperand<ValueType>::Fused && (isSum || isDifference) &&
+                IsProduct<Right>::value)
+            {
+                if (!right_.References(result))
+                {
+                    Assign(left_, result);
+                    if (isSum)
+                    {
+                        ValueType::AddMul(right_.LeftOperand(), right_.RightOperand(), result);
+                    }
+                    else
+                    {
+                        ValueType::SubMul(right_.LeftOperand(), right_.RightOperand(), result);
+                    }
+                    return;
+                }
+            }
+            // result = a * b + right
+            if constexpr (LongOperand<ValueType>::Fused && isSum && IsProduct<Left>::value)
+            {
+                if (!left_.References(result))
+                {
+                    Assign(right_, result);
+                    ValueType::AddMul(left_.LeftOperand(), left_.RightOperand(), result);
+                    return;
+                }
+            }
+
+            if constexpr (LongOperand<Left>::IsValue && LongOperand<Right>::IsValue)
+            {
+                Operation::Apply(left_, right_, result);
+                return;
+            }
+            // Operations take an operand aliased with result
+            if constexpr (LongOperand<Left>::IsExpression && LongOperand<Right>::IsValue)
+            {
+                if (std::addressof(right_) != std::addressof(result))
+                {
+                    left_.EvaluateInto(result);
+                    Operation::Apply(result, right_, result);
+                    return;
+                }
+            }
+            if constexpr (isCommutative &&
+                LongOperand<Left>::IsValue && LongOperand<Right>::IsExpression)
+            {
+                if (std::addressof(left_) != std::addressof(result))
+                {
+                    right_.EvaluateInto(result);
+                    Operation::Apply(left_, result, result);
+                    return;
+                }
+            }
+            ValueType leftValue, rightValue;
+            Operation::Apply(Evaluate(left_, leftValue), Evaluate(right_, rightValue), result);
+        }
+
+    private:
+        template <typename Operand>
+        struct IsProduct
+        {
+            static const bool value = false;
+        };
+
+        template <typename ProductLeft, typename ProductRight>
+        struct IsProduct<LongExpression<MultiplyOperation, ProductLeft, ProductRight>>
+        {
+            static const bool value = LongOperand<ProductLeft>::IsValue &&
+                LongOperand<ProductRight>::IsValue;
+        };
+
+        template <typename Operand>
+        static bool Refers(const Operand& operand, const ValueType& value)
+        {
+            if constexpr (LongOperand<Operand>::IsExpression)
+            {
+                return operand.References(value);
+            }
+            else
+            {
+                return std::addressof(operand) == std::addressof(value);
+            }
+        }
+
+        template <typename Operand>
+        static void Assign(const Operand& operand, ValueType& result)
+        {
+            if constexpr (LongOperand<Operand>::IsExpression)
+            {
+                operand.EvaluateInto(result);
+            }
+            else if (std::addressof(operand) != std::addressof(result))
+            {
+                result = operand;
+            }
+        }
+
+        // Returns value of operand, expressions are evaluated into temporary
+        template <typename Operand>
+        static const ValueType& Evaluate(const Operand& operand, ValueType& temporary)
+        {
+            if constexpr (LongOperand<Operand>::IsExpression)
+            {
+                operand.EvaluateInto(temporary);
+                return temporary;
+            }
+            else
+            {
+                return operand;
+            }
+        }
+
+        using LeftStorage = typename std::conditional<LongOperand<Left>::IsExpression,
+            Left, const Left&>::type;
+        using RightStorage = typename std::conditional<LongOperand<Right>::IsExpression,
+            Right, const Right&>::type;
+
+        LeftStorage left_;
+        RightStorage right_;
+    };
+
+    // Expression of operation, if both operands are values or expressions
+    // of the same type
+    template <typename Operation, typename Left, typename Right>
+    using LongExpressionType = typename std::enable_if<
+        (LongOperand<Left>::IsValue || LongOperand<Left>::IsExpression) &&
+        (LongOperand<Right>::IsValue || LongOperand<Right>::IsExpression) &&
+        std::is_same<typename LongOperand<Left>::ValueType,
+            typename LongOperand<Right>::ValueType>::value,
+        LongExpression<Operation, Left, Right>>::type;
+
+    // Reference to value, if operand of compound assignment is a value or
+    // an expression of the same type
+    template <typename Value, typename Operand>
+    using LongCompoundType = typename std::enable_if<
+        (LongOperand<Operand>::IsValue || LongOperand<Operand>::IsExpression) &&
+        std::is_same<typename LongOperand<Operand>::ValueType, Value>::value,
+        Value&>::type;
+
+    template <typename Left, typename Right>
+    LongExpressionType<AddOperation, Left, Right> operator + (const Left& left, const Right& right)
+    {
+        return LongExpression<AddOperation, Left, Right>(left, right);
+    }
+
+    template <typename Left, typename Right>
+    LongExpressionType<SubtractOperation, Left, Right> operator - (const Left& left, const Right& right)
+    {
+        return LongExpression<SubtractOperation, Left, Right>(left, right);
+    }
+
+    template <typename Left, typename Right>
+    LongExpressionType<MultiplyOperation, Left, Right> operator * (const Left& left, const Right& right)
+    {
+        return LongExpression<MultiplyOperation, Left, Right>(left, right);
+    }
+
+    template <typename Left, typename Right>
+    LongExpressionType<DivideOperation, Left, Right> operator / (const Left& left, const Right& right)
+    {
+        return LongExpression<DivideOperation, Left, Right>(left, right);
+    }
+
+    template <typename Left, typename Right>
+    LongExpressionType<ModOperation, Left, Right> operator % (const Left& left, const Right& right)
+    {
+        return LongExpression<ModOperation, Left, Right>(left, right);
+    }
+};
+
+#endif
@@ -0,0 +1,426 @@
+#ifndef LONG_ARITHMETIC_LONG_FLOAT_H_
+#define LONG_ARITHMETIC_LONG_FLOAT_H_
+
+#include "long_rational.h"
+
+namespace LongArithmetic
+{
+    // Floating-point numbers mantissa * Base^exponent with bounded precision.
+    // Precision is a maximal number of digits of mantissa in Base scale of notation,
+    // results of operations are rounded to precision and rounding mode of result.
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongFloat
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using RationalType = LongRational<Traits, Base>;
+        using IntType = typename IntegerType::IntType;
+        using SizeType = typename IntegerType::SizeType;
+        using ValueType = typename IntegerType::ValueType;
+        using DigitType = typename IntegerType::DigitType;
+        using SignType = typename IntegerType::SignType;
+        using ExponentType = IntType;
+
+        static_assert(Base % 2 == 0, "Rounding to nearest requires even base");
+
+        LongFloat()
+            : mantissa_(0)
+            , exponent_(0)
+            , precision_(DEFAULT_FLOAT_PRECISION)
+            , rounding_(RoundingMode::ToNearest)
+        {
+        }
+
+        // Creates number mantissa * Base^exponent
+        LongFloat(const IntegerType& mantissa,
+            ExponentType exponent,
+            SizeType precision = DEFAULT_FLOAT_PRECISION,
+            RoundingMode rounding = RoundingMode::ToNearest)
+            : mantissa_(mantissa)
+            , exponent_(exponent)
+            , precision_(precision)
+            , rounding_(rounding)
+        {
+            Normalize();
+        }
+
+        explicit LongFloat(const RationalType& rational,
+            SizeType precision = DEFAULT_FLOAT_PRECISION,
+            RoundingMode rounding = RoundingMode::ToNearest)
+            : mantissa_(0)
+            , exponent_(0)
+            , precision_(precision)
+            , rounding_(rounding)
+        {
+            DivideMantissas(rational.Numerator(), 0, rational.Denominator(), 0, *this);
+        }
+
+        LongFloat(const LongFloat<Traits, Base>& number)
+            : mantissa_(number.mantissa_)
+            , exponent_(number.exponent_)
+            , precision_(number.precision_)
+            , rounding_(number.rounding_)
+        {
+        }
+
+        // Assigns value of number rounded to precision of this
+        LongFloat<Traits, Base>& operator = (const LongFloat<Traits, Base>& number)
+        {
+            if (this != std::addressof(number))
+            {
+                mantissa_ = number.mantissa_;
+                exponent_ = number.exponent_;
+                Normalize();
+            }
+            return *this;
+        }
+
+        static int Compare(const LongFloat<Traits, Base>& lhs,
+            const LongFloat<Traits, Base>& rhs)
+        {
+            if (lhs.Sign() != rhs.Sign())
+            {
+                return lhs.Sign() > rhs.Sign() ? 1 : -1;
+            }
+            if (lhs.IsZero() || rhs.IsZero())
+            {
+                return lhs.IsZero() ? (rhs.IsZero() ? 0 : -rhs.Sign()) : lhs.Sign();
+            }
+            int sign = lhs.Sign();
+            ExponentType lhsTop = lhs.exponent_ + lhs.mantissa_.Length();
+            ExponentType rhsTop = rhs.exponent_ + rhs.mantissa_.Length();
+            if (lhsTop != rhsTop)
+            {
+                return lhsTop > rhsTop ? sign : -sign;
+            }
+            ExponentType bottom = std::min(lhs.exponent_, rhs.exponent_);
+            for (ExponentType position = lhsTop - 1; position >= bottom; --position)
+            {
+                DigitType lhsDigit = lhs.DigitAt(position);
+                DigitType rhsDigit = rhs.DigitAt(position);
+                if (lhsDigit != rhsDigit)
+                {
+                    return lhsDigit > rhsDigit ? sign : -sign;
+                }
+            }
+            return 0;
+        }
+
+        static void Add(const LongFloat<Traits, Base>& number,
+            const LongFloat<Traits, Base>& summand,
+            LongFloat<Traits, Base>& result)
+        {
+            AddSigned(number, summand, 1, result);
+        }
+
+        static void Subtract(const LongFloat<Traits, Base>& number,
+            const LongFloat<Traits, Base>& subtrahend,
+            LongFloat<Traits, Base>& result)
+        {
+            AddSigned(number, subtrahend, -1, result);
+        }
+
+        static void Multiply(const LongFloat<Traits, Base>& number,
+            const LongFloat<Traits, Base>& multiplier,
+            LongFloat<Traits, Base>& result)
+        {
+            IntegerType product;
+            IntegerType::Multiply(number.mantissa_, multiplier.mantissa_, product);
+            result.exponent_ = number.exponent_ + multiplier.exponent_;
+            result.mantissa_.Swap(product);
+            result.Normalize();
+        }
+
+        static void Divide(const LongFloat<Traits, Base>& number,
+            const LongFloat<Traits, Base>& divisor,
+            LongFloat<Traits, Base>& result)
+        {
+            DivideMantissas(number.mantissa_, number.exponent_,
+                divisor.mantissa_, divisor.exponent_, result);
+        }
+
+        static void Sqrt(const LongFloat<Traits, Base>& number,
+            LongFloat<Traits, Base>& result)
+        {
+            if (number.Sign() < 0)
+            {
+                throw std::domain_error("Square root of negative number");
+            }
+            // Root must have at least one digit more than precision
+            // and exponent of radicand must be even
+            ExponentType shift = 2 * (ExponentType(result.precision_) + 1) -
+                number.mantissa_.Length();
+            if (shift < 0)
+            {
+                shift = 0;
+            }
+            if ((number.exponent_ - shift) % 2 != 0)
+            {
+                ++shift;
+            }
+            IntegerType radicand, root, surplus;
+            IntegerType::ShiftLeft(number.mantissa_, static_cast<SizeType>(shift), radicand);
+            IntegerType::SqrtRem(radicand, root, surplus);
+            result.exponent_ = (number.exponent_ - shift) / 2;
+            result.mantissa_.Swap(root);
+            if (!surplus.IsZero())
+            {
+                result.AppendSticky(1);
+            }
+            result.Normalize();
+        }
+
+        // Returns exact value of number
+        RationalType ToRational() const
+        {
+            if (exponent_ >= 0)
+            {
+                IntegerType numerator;
+                IntegerType::ShiftLeft(mantissa_, static_cast<SizeType>(exponent_), numerator);
+                return RationalType(numerator);
+            }
+            IntegerType denominator;
+            IntegerType::ShiftLeft(IntegerType(1), static_cast<SizeType>(-exponent_), denominator);
+            return RationalType(mantissa_, denominator);
+        }
+
+        // Writes number as mantissa and exponent of ten
+        // if Base is a power of ten and as mantissa and exponent of Base otherwise
+        friend std::ostream& operator << (std::ostream& out,
+            const LongFloat<Traits, Base>& number)
+        {
+            out << number.mantissa_;
+            if (number.exponent_ != 0)
+            {
+                IntType decimalLength = LongNumber<Traits, Base>::DecimalLength();
+                if (decimalLength > 0)
+                {
+                    out << 'e' << number.exponent_ * decimalLength;
+                }
+                else
+                {
+                    out << '*' << Base << '^' << number.exponent_;
+                }
+            }
+            return out;
+        }
+
+        // Rounds mantissa to precision and removes its trailing zero digits
+        void Normalize()
+        {
+            if (precision_ == 0)
+            {
+                throw std::invalid_argument("Zero precision");
+            }
+            if (mantissa_.IsZero())
+            {
+                exponent_ = 0;
+                return;
+            }
+            SizeType length = mantissa_.Length();
+            if (length > precision_)
+            {
+                SizeType shift = length - precision_;
+                DigitType topDigit = mantissa_.GetDigit(shift - 1);
+                bool restZero = true;
+                for (IntType i = 0; i < IntType(shift) - 1 && restZero; ++i)
+                {
+                    restZero = mantissa_.GetDigit(i) == 0;
+                }
+                int halfComparison = topDigit > Base / 2 ? 1 :
+                    topDigit < Base / 2 ? -1 :
+                    restZero ? 0 : 1;
+                bool exact = topDigit == 0 && restZero;
+
+                SignType sign = mantissa_.Sign();
+                IntegerType::ShiftRight(mantissa_, shift, mantissa_);
+                exponent_ += shift;
+
+                bool increment = RoundsAwayFromZero(rounding_, sign, halfComparison,
+                    exact, mantissa_.GetDigit(0) % 2 != 0);
+                if (increment)
+                {
+                    IntegerType::Add(mantissa_, IntegerType(sign), mantissa_);
+                }
+            }
+            SizeType zeros = 0;
+            while (mantissa_.GetDigit(zeros) == 0)
+            {
+                ++zeros;
+            }
+            if (zeros > 0)
+            {
+                IntegerType::ShiftRight(mantissa_, zeros, mantissa_);
+                exponent_ += zeros;
+            }
+        }
+
+        const IntegerType& Mantissa() const
+        {
+            return mantissa_;
+        }
+
+        ExponentType Exponent() const
+        {
+            return exponent_;
+        }
+
+        SizeType& Precision()
+        {
+            return precision_;
+        }
+
+        SizeType Precision() const
+        {
+            return precision_;
+        }
+
+        RoundingMode& Rounding()
+        {
+            return rounding_;
+        }
+
+        RoundingMode Rounding() const
+        {
+            return rounding_;
+        }
+
+        SignType Sign() const
+        {
+            return mantissa_.Sign();
+        }
+
+        bool IsZero() const
+        {
+            return mantissa_.IsZero();
+        }
+
+    private:
+        // Returns digit of number at position of Base^position
+        DigitType DigitAt(ExponentType position) const
+        {
+            if (position < exponent_ || position >= exponent_ + mantissa_.Length())
+            {
+                return 0;
+            }
+            return mantissa_.GetDigit(position - exponent_);
+        }
+
+        // Appends a digit below mantissa which stands for nonzero discarded digits.
+        // Rounding is not affected while the sticky digit is below rounding position.
+        void AppendSticky(DigitType digit)
+        {
+            IntegerType::ShiftLeft(mantissa_, 1, mantissa_);
+            IntegerType::Add(mantissa_, IntegerType(ValueType(mantissa_.Sign() * digit)), mantissa_);
+            --exponent_;
+        }
+
+        // Discards digits of mantissa below Base^cut keeping a sticky digit for them
+        static void Truncate(IntegerType& mantissa, ExponentType& exponent, ExponentType cut)
+        {
+            if (exponent >= cut)
+            {
+                return;
+            }
+            SizeType drop = static_cast<SizeType>(cut - exponent);
+            SignType sign = mantissa.Sign();
+            bool dropZero = true;
+            for (SizeType i = 0; i < drop && i < mantissa.Length() && dropZero; ++i)
+            {
+                dropZero = mantissa.GetDigit(i) == 0;
+            }
+            IntegerType::ShiftRight(mantissa, drop, mantissa);
+            exponent = cut;
+            if (!dropZero)
+            {
+                IntegerType::ShiftLeft(mantissa, 1, mantissa);
+                IntegerType::Add(mantissa, IntegerType(ValueType(sign)), mantissa);
+                --exponent;
+            }
+        }
+
+        static void AddSigned(const LongFloat<Traits, Base>& number,
+            const LongFloat<Traits, Base>& summand,
+            SignType summandSign,
+            LongFloat<Traits, Base>& result)
+        {
+            IntegerType lhs(number.mantissa_);
+            IntegerType rhs(summand.mantissa_);
+            if (!rhs.IsZero())
+            {
+                rhs.Sign() *= summandSign;
+            }
+            ExponentType lhsExponent = number.exponent_;
+            ExponentType rhsExponent = summand.exponent_;
+            if (lhs.IsZero() || rhs.IsZero())
+            {
+                result.mantissa_.Swap(lhs.IsZero() ? rhs : lhs);
+                result.exponent_ = lhs.IsZero() ? rhsExponent : lhsExponent;
+                result.Normalize();
+                return;
+            }
+
+            // Operand whose leading digit is far below the leading digit of the other one
+            // affects only rounding, so its digits below both the other operand
+            // and the rounding position are replaced with a sticky digit.
+            // Otherwise operands may cancel and their sum is computed exactly
+            ExponentType lhsTop = lhsExponent + ExponentType(lhs.Length());
+            ExponentType rhsTop = rhsExponent + ExponentType(rhs.Length());
+            ExponentType gap = ExponentType(result.precision_) + 2;
+            if (lhsTop - rhsTop > gap)
+            {
+                Truncate(rhs, rhsExponent, std::min(lhsExponent, lhsTop - gap));
+            }
+            else if (rhsTop - lhsTop > gap)
+            {
+                Truncate(lhs, lhsExponent, std::min(rhsExponent, rhsTop - gap));
+            }
+
+            ExponentType exponent = std::min(lhsExponent, rhsExponent);
+            IntegerType::ShiftLeft(lhs, static_cast<SizeType>(lhsExponent - exponent), lhs);
+            IntegerType::ShiftLeft(rhs, static_cast<SizeType>(rhsExponent - exponent), rhs);
+            IntegerType::Add(lhs, rhs, result.mantissa_);
+            result.exponent_ = exponent;
+            result.Normalize();
+        }
+
+        // Writes (number * Base^numberExponent) / (divisor * Base^divisorExponent)
+        // rounded to precision of result into result
+        static void DivideMantissas(const IntegerType& number,
+            ExponentType numberExponent,
+            const IntegerType& divisor,
+            ExponentType divisorExponent,
+            LongFloat<Traits, Base>& result)
+        {
+            if (divisor.IsZero())
+            {
+                throw std::domain_error("Division by zero");
+            }
+            // Quotient must have at least one digit more than precision
+            ExponentType shift = ExponentType(result.precision_) + 1 +
+                divisor.Length() - number.Length();
+            if (shift < 0)
+            {
+                shift = 0;
+            }
+            IntegerType dividend, quotient, surplus;
+            IntegerType::ShiftLeft(number, static_cast<SizeType>(shift), dividend);
+            IntegerType::DivMod(dividend, divisor, quotient, surplus);
+            result.mantissa_.Swap(quotient);
+            result.exponent_ = numberExponent - divisorExponent - shift;
+            if (!surplus.IsZero())
+            {
+                result.AppendSticky(1);
+            }
+            result.Normalize();
+        }
+
+    private:
+        IntegerType mantissa_;
+        ExponentType exponent_;
+        SizeType precision_;
+        RoundingMode rounding_;
+    };
+};
+
+#endif
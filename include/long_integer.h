@@ -1,10 +1,43 @@
 #ifndef LONG_ARITHMETIC_LONG_INTEGER_H_
 #define LONG_ARITHMETIC_LONG_INTEGER_H_
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "long_expression.h"
 #include "long_number.h"
 
 namespace LongArithmetic
 {
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongPreparedDivisor;
+
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongPreparedMultiplier;
+
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongAccumulator;
+
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongModularContext;
+
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongDiskNumber;
+
+    // Result of operations with native integers of type Native.
+    // Booleans and characters are not treated as numbers
+    template <typename Native, typename Result = void>
+    using LongNativeType = typename std::enable_if<std::is_integral<Native>::value &&
+        !std::is_same<Native, bool>::value &&
+        !std::is_same<Native, char>::value &&
+        !std::is_same<Native, signed char>::value &&
+        !std::is_same<Native, unsigned char>::value &&
+        !std::is_same<Native, wchar_t>::value &&
+        !std::is_same<Native, char16_t>::value &&
+        !std::is_same<Native, char32_t>::value,
+        Result>::type;
+
     // Integers numbers of arbitrary size
     template <typename Traits, typename Traits::BaseType Base>
     class LongInteger
@@ -15,6 +48,7 @@ namespace LongArithmetic
         using IntType = typename NumberType::IntType;
         using SizeType = typename NumberType::SizeType;
         using ValueType = typename NumberType::ValueType;
+        using UnsignedValueType = typename NumberType::UnsignedValueType;
         using DigitType = typename NumberType::DigitType;
 
         LongInteger()
@@ -23,12 +57,12 @@ namespace LongArithmetic
         {}
 
         explicit LongInteger(ValueType integer)
-            : value_(integer >= 0 ? integer : -integer)
+            : value_(NativeMagnitude(integer))
             , sign_(integer >= 0 ? 1 : -1)
         {}
 
         LongInteger(ValueType integer, SizeType integerSize)
-            : value_(integer >= 0 ? integer : -integer, integerSize)
+            : value_(NativeMagnitude(integer), integerSize)
             , sign_(integer >= 0 ? 1 : -1)
         {}
 
@@ -37,6 +71,8 @@ namespace LongArithmetic
             , sign_(number.sign_)
         {}
 
+        LongInteger(LongInteger&& number) = default;
+
         LongInteger<Traits, Base>& operator = (const LongInteger<Traits, Base>& number)
         {
             if (this != std::addressof(number))
@@ -47,6 +83,59 @@ namespace LongArithmetic
             return *this;
         }
 
+        LongInteger<Traits, Base>& operator = (LongInteger<Traits, Base>&& number) = default;
+
+        // Values of expressions are written into existing digits
+        template <typename Expression,
+            typename = typename std::enable_if<LongOperand<Expression>::IsExpression &&
+                std::is_same<typename LongOperand<Expression>::ValueType,
+                    LongInteger<Traits, Base>>::value>::type>
+        LongInteger(const Expression& expression)
+            : LongInteger()
+        {
+            expression.EvaluateInto(*this);
+        }
+
+        template <typename Expression>
+        typename std::enable_if<LongOperand<Expression>::IsExpression &&
+            std::is_same<typename LongOperand<Expression>::ValueType,
+                LongInteger<Traits, Base>>::value, LongInteger<Traits, Base>&>::type
+        operator = (const Expression& expression)
+        {
+            expression.EvaluateInto(*this);
+            return *this;
+        }
+
+        template <typename Operand>
+        LongCompoundType<LongInteger<Traits, Base>, Operand> operator += (const Operand& operand)
+        {
+            return *this = LongExpression<AddOperation, LongInteger<Traits, Base>, Operand>(*this, operand);
+        }
+
+        template <typename Operand>
+        LongCompoundType<LongInteger<Traits, Base>, Operand> operator -= (const Operand& operand)
+        {
+            return *this = LongExpression<SubtractOperation, LongInteger<Traits, Base>, Operand>(*this, operand);
+        }
+
+        template <typename Operand>
+        LongCompoundType<LongInteger<Traits, Base>, Operand> operator *= (const Operand& operand)
+        {
+            return *this = LongExpression<MultiplyOperation, LongInteger<Traits, Base>, Operand>(*this, operand);
+        }
+
+        template <typename Operand>
+        LongCompoundType<LongInteger<Traits, Base>, Operand> operator /= (const Operand& operand)
+        {
+            return *this = LongExpression<DivideOperation, LongInteger<Traits, Base>, Operand>(*this, operand);
+        }
+
+        template <typename Operand>
+        LongCompoundType<LongInteger<Traits, Base>, Operand> operator %= (const Operand& operand)
+        {
+            return *this = LongExpression<ModOperation, LongInteger<Traits, Base>, Operand>(*this, operand);
+        }
+
         static int Compare(const LongInteger<Traits, Base>& lhs,
             const LongInteger<Traits, Base>& rhs)
         {
@@ -183,50 +272,542 @@ namespace LongArithmetic
             }
         }
 
+        // Function writes quotient of number over divisor rounded towards zero into result
         static void Divide(const LongInteger<Traits, Base>& number,
             const LongInteger<Traits, Base>& divisor,
             LongInteger<Traits, Base>& result)
         {
-            if (NumberType::Compare(number.value_, divisor.value_) != -1)
+            if (divisor.IsZero())
             {
-                result.value_.Reserve(
-                    number.value_.Length() - divisor.value_.Length() + 1);
-                LongInteger<Traits, Base> surplus(0, divisor.value_.Length());
-                NumberType::Divide(number.value_, divisor.value_,
-                    result.value_, surplus.value_);
-                result.sign_ = number.sign_ * divisor.sign_;
-                result.TestZeroSign();
+                throw std::domain_error("Division by zero");
             }
-            else
+            if (std::addressof(result) == std::addressof(divisor))
             {
-                result = LongInteger(0);
+                LongInteger<Traits, Base> divisorCopy(divisor);
+                Divide(number, divisorCopy, result);
+                return;
             }
+            SignType sign = number.sign_ * divisor.sign_;
+            result.value_.Reserve(number.value_.Length() + 1);
+            NumberType::Divide(number.value_, divisor.value_, result.value_);
+            result.sign_ = sign;
+            result.TestZeroSign();
         }
 
+        // Function writes remainder of division of number over divisor into result,
+        // the remainder has sign of number
         static void Mod(const LongInteger<Traits, Base>& number,
             const LongInteger<Traits, Base>& divisor,
             LongInteger<Traits, Base>& result)
         {
-            if (NumberType::Compare(number.value_, divisor.value_) != -1)
+            if (divisor.IsZero())
             {
-                result.value_.Reserve(
-                    number.value_.Length() - divisor.value_.Length() + 1);
-                LongInteger<Traits, Base> quotient(0, number.value_.Length() -
-                    divisor.value_.Length() + 1);
-                NumberType::Divide(number.value_, divisor.value_,
-                    quotient.value_, result.value_);
-                result.sign_ = number.sign_;
-                result.TestZeroSign();
+                throw std::domain_error("Division by zero");
             }
-            else
+            SignType sign = number.sign_;
+            result.value_.Reserve(divisor.value_.Length() + 1);
+            NumberType::Mod(number.value_, divisor.value_, result.value_);
+            result.sign_ = sign;
+            result.TestZeroSign();
+        }
+
+        // Function adds product of number and multiplier to result
+        static void AddMul(const LongInteger<Traits, Base>& number,
+            const LongInteger<Traits, Base>& multiplier,
+            LongInteger<Traits, Base>& result)
+        {
+            AddProduct(number, multiplier, number.sign_ * multiplier.sign_, result);
+        }
+
+        // Function subtracts product of number and multiplier from result
+        static void SubMul(const LongInteger<Traits, Base>& number,
+            const LongInteger<Traits, Base>& multiplier,
+            LongInteger<Traits, Base>& result)
+        {
+            AddProduct(number, multiplier, -number.sign_ * multiplier.sign_, result);
+        }
+
+        // Function writes product of number and prepared multiplier into result
+        static void Multiply(const LongInteger<Traits, Base>& number,
+            const LongPreparedMultiplier<Traits, Base>& multiplier,
+            LongInteger<Traits, Base>& result)
+        {
+            const LongInteger<Traits, Base>& value = multiplier.Multiplier();
+            SizeType numberLength = number.value_.Length();
+            SizeType multiplierLength = value.value_.Length();
+            if (!NumberType::UsesTransform(numberLength, multiplierLength))
+            {
+                Multiply(number, value, result);
+                return;
+            }
+            SignType sign = number.sign_ * value.sign_;
+            result.value_.Reserve(numberLength + multiplierLength);
+            NumberType::MultiplyTransformed(number.value_,
+                multiplier.Transform(NumberType::TransformSize(numberLength, multiplierLength)),
+                multiplierLength, result.value_);
+            result.sign_ = sign;
+            result.TestZeroSign();
+        }
+
+        // Function writes quotient of number over prepared divisor into result
+        static void Divide(const LongInteger<Traits, Base>& number,
+            const LongPreparedDivisor<Traits, Base>& divisor,
+            LongInteger<Traits, Base>& result)
+        {
+            const LongInteger<Traits, Base>& value = divisor.Divisor();
+            SignType sign = number.sign_ * value.sign_;
+            result.value_.Reserve(number.value_.Length() + 1);
+            NumberType::DivideByReciprocal(number.value_, value.value_,
+                divisor.Reciprocal(), &result.value_, nullptr);
+            result.sign_ = sign;
+            result.TestZeroSign();
+        }
+
+        // Function writes remainder of division of number over prepared divisor
+        // into result, the remainder has sign of number
+        static void Mod(const LongInteger<Traits, Base>& number,
+            const LongPreparedDivisor<Traits, Base>& divisor,
+            LongInteger<Traits, Base>& result)
+        {
+            const LongInteger<Traits, Base>& value = divisor.Divisor();
+            SignType sign = number.sign_;
+            result.value_.Reserve(value.value_.Length() + 1);
+            NumberType::DivideByReciprocal(number.value_, value.value_,
+                divisor.Reciprocal(), nullptr, &result.value_);
+            result.sign_ = sign;
+            result.TestZeroSign();
+        }
+
+        // Function writes quotient of number over divisor into result,
+        // number must be divisible by divisor
+        static void DivideExact(const LongInteger<Traits, Base>& number,
+            const LongInteger<Traits, Base>& divisor,
+            LongInteger<Traits, Base>& result)
+        {
+            if (divisor.IsZero())
+            {
+                throw std::domain_error("Division by zero");
+            }
+            if (std::addressof(result) == std::addressof(divisor))
+            {
+                LongInteger<Traits, Base> divisorCopy(divisor);
+                DivideExact(number, divisorCopy, result);
+                return;
+            }
+            SignType sign = number.sign_ * divisor.sign_;
+            result.value_.Reserve(number.value_.Length() + 1);
+            NumberType::DivideExact(number.value_, divisor.value_, result.value_);
+            result.sign_ = sign;
+            result.TestZeroSign();
+        }
+
+        // Function writes quotient of number over divisor rounded according to rounding
+        // into quotient and number - quotient * divisor into surplus
+        // computing both by single long division.
+        // TowardZero, Downward and Upward give truncating, floor and ceiling division.
+        static void DivMod(const LongInteger<Traits, Base>& number,
+            const LongInteger<Traits, Base>& divisor,
+            LongInteger<Traits, Base>& quotient,
+            LongInteger<Traits, Base>& surplus,
+            RoundingMode rounding = RoundingMode::TowardZero)
+        {
+            if (divisor.IsZero())
+            {
+                throw std::domain_error("Division by zero");
+            }
+            if (std::addressof(quotient) == std::addressof(divisor) ||
+                std::addressof(surplus) == std::addressof(divisor))
+            {
+                LongInteger<Traits, Base> divisorCopy(divisor);
+                DivMod(number, divisorCopy, quotient, surplus, rounding);
+                return;
+            }
+            SignType numberSign = number.sign_;
+            SignType sign = number.sign_ * divisor.sign_;
+            quotient.value_.Reserve(number.value_.Length() + 1);
+            surplus.value_.Reserve(divisor.value_.Length() + 1);
+            NumberType::Divide(number.value_, divisor.value_, quotient.value_, surplus.value_);
+            quotient.sign_ = sign;
+            quotient.TestZeroSign();
+            surplus.sign_ = numberSign;
+            surplus.TestZeroSign();
+            if (rounding == RoundingMode::TowardZero || surplus.IsZero())
+            {
+                return;
+            }
+
+            int halfComparison = -1;
+            if (rounding == RoundingMode::ToNearest || rounding == RoundingMode::ToNearestAway)
+            {
+                NumberType doubledSurplus(0, surplus.value_.Length() + 1);
+                NumberType::Add(surplus.value_, surplus.value_, doubledSurplus);
+                halfComparison = NumberType::Compare(doubledSurplus, divisor.value_);
+            }
+            if (RoundsAwayFromZero(rounding, sign, halfComparison, false,
+                quotient.value_.GetDigit(0) % 2 != 0))
+            {
+                Add(quotient, static_cast<int>(sign), quotient);
+                if (sign > 0)
+                {
+                    Subtract(surplus, divisor, surplus);
+                }
+                else
+                {
+                    Add(surplus, divisor, surplus);
+                }
+            }
+        }
+
+        // Operations with native integers do not create temporary long numbers
+
+        template <typename Native>
+        static LongNativeType<Native, int>
+        Compare(const LongInteger<Traits, Base>& lhs, Native rhs)
+        {
+            SignType sign = NativeSign(rhs);
+            if (lhs.sign_ != sign)
+            {
+                return lhs.sign_ > sign ? 1 : -1;
+            }
+            return sign * NumberType::Compare(lhs.value_, NativeMagnitude(rhs));
+        }
+
+        template <typename Native>
+        static LongNativeType<Native>
+        Add(const LongInteger<Traits, Base>& number,
+            Native summand,
+            LongInteger<Traits, Base>& result)
+        {
+            AddNative(number, NativeMagnitude(summand), NativeSign(summand), result);
+        }
+
+        template <typename Native>
+        static LongNativeType<Native>
+        Subtract(const LongInteger<Traits, Base>& number,
+            Native subtrahend,
+            LongInteger<Traits, Base>& result)
+        {
+            AddNative(number, NativeMagnitude(subtrahend), -NativeSign(subtrahend), result);
+        }
+
+        template <typename Native>
+        static LongNativeType<Native>
+        Multiply(const LongInteger<Traits, Base>& number,
+            Native multiplier,
+            LongInteger<Traits, Base>& result)
+        {
+            result.value_.Reserve(number.value_.Length() + NumberType::NativeLength());
+            NumberType::Multiply(number.value_, NativeMagnitude(multiplier), result.value_);
+            result.sign_ = number.sign_ * NativeSign(multiplier);
+            result.TestZeroSign();
+        }
+
+        template <typename Native>
+        static LongNativeType<Native>
+        Divide(const LongInteger<Traits, Base>& number,
+            Native divisor,
+            LongInteger<Traits, Base>& result)
+        {
+            if (divisor == 0)
+            {
+                throw std::domain_error("Division by zero");
+            }
+            UnsignedValueType surplus;
+            result.value_.Reserve(number.value_.Length());
+            NumberType::Divide(number.value_, NativeMagnitude(divisor), result.value_, surplus);
+            result.sign_ = number.sign_ * NativeSign(divisor);
+            result.TestZeroSign();
+        }
+
+        template <typename Native>
+        static LongNativeType<Native>
+        Mod(const LongInteger<Traits, Base>& number,
+            Native divisor,
+            LongInteger<Traits, Base>& result)
+        {
+            if (divisor == 0)
+            {
+                throw std::domain_error("Division by zero");
+            }
+            SignType sign = number.sign_;
+            result.value_.Assign(SmallRemainder(number, NativeMagnitude(divisor)));
+            result.sign_ = sign;
+            result.TestZeroSign();
+        }
+
+        // Function adds product of number and multiplier to result
+        template <typename Native>
+        static LongNativeType<Native>
+        AddMul(const LongInteger<Traits, Base>& number,
+            Native multiplier,
+            LongInteger<Traits, Base>& result)
+        {
+            AddNativeProduct(number, NativeMagnitude(multiplier),
+                number.sign_ * NativeSign(multiplier), result);
+        }
+
+        // Function subtracts product of number and multiplier from result
+        template <typename Native>
+        static LongNativeType<Native>
+        SubMul(const LongInteger<Traits, Base>& number,
+            Native multiplier,
+            LongInteger<Traits, Base>& result)
+        {
+            AddNativeProduct(number, NativeMagnitude(multiplier),
+                -number.sign_ * NativeSign(multiplier), result);
+        }
+
+        // Compares number with product of multiplier and native integer
+        template <typename Native>
+        static LongNativeType<Native, int>
+        CompareProduct(const LongInteger<Traits, Base>& number,
+            const LongInteger<Traits, Base>& multiplier,
+            Native integer)
+        {
+            int numberSign = number.IsZero() ? 0 : number.sign_;
+            int productSign = multiplier.IsZero() || integer == 0 ?
+                0 : multiplier.sign_ * NativeSign(integer);
+            if (numberSign != productSign)
+            {
+                return numberSign > productSign ? 1 : -1;
+            }
+            if (numberSign == 0)
+            {
+                return 0;
+            }
+            return numberSign *
+                NumberType::CompareProduct(number.value_, multiplier.value_, NativeMagnitude(integer));
+        }
+
+        // Absolute value of native integer
+        template <typename Native>
+        static UnsignedValueType NativeMagnitude(Native integer)
+        {
+            return integer < 0 ?
+                UnsignedValueType(-(integer + 1)) + 1 :
+                UnsignedValueType(integer);
+        }
+
+        // Returns remainder of division of absolute value of number over divisor
+        static UnsignedValueType SmallRemainder(const LongInteger<Traits, Base>& number,
+            UnsignedValueType divisor)
+        {
+            return NumberType::Remainder(number.value_, divisor);
+        }
+
+        // Function writes product of number and numeral into result
+        static void SmallMultiply(const LongInteger<Traits, Base>& number,
+            const DigitType numeral,
+            LongInteger<Traits, Base>& result)
+        {
+            result.value_.Reserve(number.value_.Length() + 1);
+            NumberType::SmallMultiply(number.value_, numeral, result.value_);
+            result.sign_ = number.sign_;
+            result.TestZeroSign();
+        }
+
+        // Function writes quotient of number over numeral rounded towards zero
+        // into result and absolute value of remainder into surplus
+        static void SmallDivide(const LongInteger<Traits, Base>& number,
+            const DigitType numeral,
+            LongInteger<Traits, Base>& result,
+            DigitType& surplus)
+        {
+            result.value_.Reserve(number.value_.Length());
+            NumberType::SmallDivide(number.value_, numeral, result.value_, surplus);
+            result.sign_ = number.sign_;
+            result.TestZeroSign();
+        }
+
+        // Function writes number multiplied by Base^shift into result
+        static void ShiftLeft(const LongInteger<Traits, Base>& number,
+            SizeType shift,
+            LongInteger<Traits, Base>& result)
+        {
+            result.value_.Reserve(number.value_.Length() + shift);
+            NumberType::ShiftLeft(number.value_, shift, result.value_);
+            result.sign_ = number.sign_;
+        }
+
+        // Function writes number divided by Base^shift and rounded towards zero into result
+        static void ShiftRight(const LongInteger<Traits, Base>& number,
+            SizeType shift,
+            LongInteger<Traits, Base>& result)
+        {
+            result.value_.Reserve(number.value_.Length());
+            NumberType::ShiftRight(number.value_, shift, result.value_);
+            result.sign_ = number.sign_;
+            result.TestZeroSign();
+        }
+
+        // Function writes number raised to the power exponent into result
+        static void Power(const LongInteger<Traits, Base>& number,
+            UnsignedValueType exponent,
+            LongInteger<Traits, Base>& result)
+        {
+            LongInteger<Traits, Base> power(number);
+            LongInteger<Traits, Base> accumulator(1);
+            LongInteger<Traits, Base> product;
+            while (exponent > 0)
+            {
+                if (exponent & 1)
+                {
+                    Multiply(accumulator, power, product);
+                    accumulator.Swap(product);
+                }
+                exponent >>= 1;
+                if (exponent > 0)
+                {
+                    Multiply(power, power, product);
+                    power.Swap(product);
+                }
+            }
+            result.Swap(accumulator);
+        }
+
+        // Function writes integer part of square root of number into result
+        static void Sqrt(const LongInteger<Traits, Base>& number,
+            LongInteger<Traits, Base>& result)
+        {
+            LongInteger<Traits, Base> surplus;
+            SqrtRem(number, result, surplus);
+        }
+
+        // Function writes integer part s of square root of number into root
+        // and number - s * s into surplus
+        static void SqrtRem(const LongInteger<Traits, Base>& number,
+            LongInteger<Traits, Base>& root,
+            LongInteger<Traits, Base>& surplus)
+        {
+            if (number.sign_ < 0)
+            {
+                throw std::domain_error("Square root of negative number");
+            }
+            LongInteger<Traits, Base> rootValue, square;
+            NewtonRoot(number, 2, rootValue);
+            Multiply(rootValue, rootValue, square);
+            Subtract(number, square, surplus);
+            root.Swap(rootValue);
+        }
+
+        // Function writes integer part of degree-th root of number into result
+        // Roots of odd degree of negative numbers are rounded towards zero
+        static void Root(const LongInteger<Traits, Base>& number,
+            UnsignedValueType degree,
+            LongInteger<Traits, Base>& result)
+        {
+            if (degree == 0)
+            {
+                throw std::domain_error("Root of zero degree");
+            }
+            if (number.sign_ < 0 && degree % 2 == 0)
+            {
+                throw std::domain_error("Root of even degree of negative number");
+            }
+            LongInteger<Traits, Base> rootValue;
+            NewtonRoot(AbsoluteValue(number), degree, rootValue);
+            rootValue.sign_ = number.sign_;
+            rootValue.TestZeroSign();
+            result.Swap(rootValue);
+        }
+
+        static bool IsPerfectSquare(const LongInteger<Traits, Base>& number)
+        {
+            if (number.sign_ < 0)
+            {
+                return false;
+            }
+            if (!IsPowerResidue(number.value_, 2))
             {
-                result = number;
+                return false;
             }
+            LongInteger<Traits, Base> root, surplus;
+            SqrtRem(number, root, surplus);
+            return surplus.IsZero();
+        }
+
+        // Checks whether number equals a^k for some integer a and k > 1
+        static bool IsPerfectPower(const LongInteger<Traits, Base>& number)
+        {
+            LongInteger<Traits, Base> modulus = AbsoluteValue(number);
+            if (modulus.value_.Length() == 1 && modulus.value_.GetDigit(0) <= 1)
+            {
+                return true;
+            }
+            if (number.sign_ > 0 && IsPerfectSquare(number))
+            {
+                return true;
+            }
+            // It suffices to check prime degrees not exceeding log2(number)
+            double logarithm = Logarithm(modulus.value_);
+            UnsignedValueType maxDegree = static_cast<UnsignedValueType>(
+                logarithm / std::log(2.0)) + 1;
+            LongInteger<Traits, Base> root, power;
+            for (UnsignedValueType degree = 3; degree <= maxDegree; degree += 2)
+            {
+                if (!IsSmallPrime(degree))
+                {
+                    continue;
+                }
+                // Roots below 2^32 are found from floating-point estimate exactly
+                // and are rejected by the lowest digit of their powers,
+                // larger roots are rejected by residues first
+                double estimate = std::exp(logarithm / degree);
+                if (estimate < 4294967296.0)
+                {
+                    DigitType candidate = SmallRootCandidate(modulus.value_, estimate, degree);
+                    if (candidate == 0)
+                    {
+                        continue;
+                    }
+                    root = LongInteger<Traits, Base>(static_cast<ValueType>(candidate));
+                }
+                else if (IsPowerResidue(modulus.value_, degree))
+                {
+                    NewtonRoot(modulus, degree, root);
+                }
+                else
+                {
+                    continue;
+                }
+                Power(root, degree, power);
+                if (!NumberType::Compare(power.value_, modulus.value_))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Writes integer given by characters [first, last) in format [-]digits into integer.
+        // Leading zeros are allowed. Returns false if the format is violated.
+        static bool ParseDecimal(const char* first, const char* last,
+            LongInteger<Traits, Base>& integer)
+        {
+            SignType sign = 1;
+            if (first != last && *first == '-')
+            {
+                sign = -1;
+                ++first;
+            }
+            if (first == last)
+            {
+                return false;
+            }
+            if (!NumberType::IsDecimal(first, last))
+            {
+                return false;
+            }
+            NumberType::ParseDecimal(first, last, integer.value_);
+            integer.sign_ = sign;
+            integer.TestZeroSign();
+            return true;
         }
 
         friend std::istream& operator >> (std::istream& in,
             LongInteger<Traits, Base>& integer)
         {
+            in >> std::ws;
             if (in.peek() == '-')
             {
                 in.get();
@@ -265,21 +846,300 @@ namespace LongArithmetic
             return modulus;
         }
 
+        // Number of digits in Base scale of notation
+        SizeType Length() const
+        {
+            return value_.Length();
+        }
+
+        DigitType GetDigit(IntType i) const
+        {
+            return value_.GetDigit(i);
+        }
+
+        bool IsZero() const
+        {
+            return value_.Length() == 1 && value_.GetDigit(0) == 0;
+        }
+
+        // Exchanges values with other integer without copying digits
+        void Swap(LongInteger<Traits, Base>& other)
+        {
+            value_.Swap(other.value_);
+            std::swap(sign_, other.sign_);
+        }
+
         ~LongInteger()
         {
             sign_ = 1;
         }
 
     private:
+        // Adds product of number and multiplier of given sign to result
+        static void AddProduct(const LongInteger<Traits, Base>& number,
+            const LongInteger<Traits, Base>& multiplier,
+            SignType sign,
+            LongInteger<Traits, Base>& result)
+        {
+            if (number.IsZero() || multiplier.IsZero())
+            {
+                return;
+            }
+            SizeType productLength = number.value_.Length() + multiplier.value_.Length();
+            bool aliased = std::addressof(result) == std::addressof(number) ||
+                std::addressof(result) == std::addressof(multiplier);
+            if (!aliased && (result.IsZero() || result.sign_ == sign))
+            {
+                result.value_.Reserve(std::max(result.value_.Length(), productLength) + 1);
+                NumberType::AddMul(number.value_, multiplier.value_, result.value_);
+                result.sign_ = sign;
+                return;
+            }
+            // Product of the opposite sign is subtracted in place,
+            // result takes sign of the product if the product is greater
+            if (!aliased)
+            {
+                result.value_.Reserve(std::max(result.value_.Length(), productLength));
+                if (NumberType::SubMul(number.value_, multiplier.value_, result.value_))
+                {
+                    result.sign_ = sign;
+                }
+                result.TestZeroSign();
+                return;
+            }
+            LongInteger<Traits, Base> product;
+            Multiply(number, multiplier, product);
+            product.sign_ = sign;
+            Add(result, product, result);
+        }
+
+        // Adds product of number and magnitude of given sign to result
+        static void AddNativeProduct(const LongInteger<Traits, Base>& number,
+            UnsignedValueType magnitude,
+            SignType sign,
+            LongInteger<Traits, Base>& result)
+        {
+            if (number.IsZero() || magnitude == 0)
+            {
+                return;
+            }
+            if (std::addressof(result) == std::addressof(number))
+            {
+                LongInteger<Traits, Base> product;
+                Multiply(number, magnitude, product);
+                product.sign_ = sign;
+                Add(result, product, result);
+                return;
+            }
+            SizeType productLength = number.value_.Length() + NumberType::NativeLength();
+            if (result.IsZero() || result.sign_ == sign)
+            {
+                result.value_.Reserve(std::max(result.value_.Length(), productLength) + 1);
+                NumberType::AddMul(number.value_, magnitude, result.value_);
+                result.sign_ = sign;
+                return;
+            }
+            // Product of the opposite sign is subtracted in place,
+            // result takes sign of the product if the product is greater
+            result.value_.Reserve(std::max(result.value_.Length(), productLength));
+            if (NumberType::SubMul(number.value_, magnitude, result.value_))
+            {
+                result.sign_ = sign;
+            }
+            result.TestZeroSign();
+        }
+
         void TestZeroSign()
         {
-            if (value_.Length() == 1 && value_.GetDigit(0) == 0)
+            if (IsZero())
             {
                 sign_ = 1;
             }
         }
 
+        template <typename Native>
+        static SignType NativeSign(Native integer)
+        {
+            return integer < 0 ? -1 : 1;
+        }
+
+        static void AddNative(const LongInteger<Traits, Base>& number,
+            UnsignedValueType magnitude,
+            SignType sign,
+            LongInteger<Traits, Base>& result)
+        {
+            result.value_.Reserve(number.value_.Length() + NumberType::NativeLength());
+            if (number.sign_ == sign)
+            {
+                NumberType::Add(number.value_, magnitude, result.value_);
+                result.sign_ = sign;
+            }
+            else if (NumberType::Compare(number.value_, magnitude) >= 0)
+            {
+                NumberType::Subtract(number.value_, magnitude, result.value_);
+                result.sign_ = number.sign_;
+            }
+            else
+            {
+                // Absolute value of number is less than magnitude and fits into native integer
+                result.value_.Assign(magnitude - NumberType::ToNative(number.value_));
+                result.sign_ = sign;
+            }
+            result.TestZeroSign();
+        }
+
+        // Computes integer part of degree-th root of non-negative number.
+        // The root of the top half of digits gives an estimate from above,
+        // which Newton iterations refine doubling the number of correct digits.
+        static void NewtonRoot(const LongInteger<Traits, Base>& number,
+            UnsignedValueType degree,
+            LongInteger<Traits, Base>& root)
+        {
+            if (number.IsZero() || degree == 1)
+            {
+                root = number;
+                return;
+            }
+            SizeType length = number.value_.Length();
+            SizeType shift = static_cast<SizeType>(length / (2 * degree));
+            LongInteger<Traits, Base> estimate;
+            if (shift == 0)
+            {
+                // Root has at most two digits, so floating-point estimate of top digits suffices
+                double value = std::exp(Logarithm(number.value_) / degree);
+                estimate = LongInteger<Traits, Base>(
+                    static_cast<ValueType>(value * (1 + 1e-9)) + 2);
+            }
+            else
+            {
+                LongInteger<Traits, Base> top;
+                top.value_.Reserve(length - shift * degree);
+                NumberType::ShiftRight(number.value_,
+                    static_cast<SizeType>(shift * degree), top.value_);
+                NewtonRoot(top, degree, estimate);
+                Add(estimate, LongInteger<Traits, Base>(1), estimate);
+                estimate.value_.Reserve(estimate.value_.Length() + shift);
+                NumberType::ShiftLeft(estimate.value_, shift, estimate.value_);
+            }
+
+            // Iterations x -> ((degree - 1) * x + number / x^(degree - 1)) / degree
+            // decrease monotonically while x exceeds the root
+            LongInteger<Traits, Base> power, quotient, next;
+            LongInteger<Traits, Base> previousDegree(static_cast<ValueType>(degree - 1));
+            LongInteger<Traits, Base> currentDegree(static_cast<ValueType>(degree));
+            while (true)
+            {
+                Power(estimate, degree - 1, power);
+                Divide(number, power, quotient);
+                Multiply(estimate, previousDegree, next);
+                Add(next, quotient, next);
+                Divide(next, currentDegree, next);
+                if (Compare(next, estimate) >= 0)
+                {
+                    break;
+                }
+                estimate.Swap(next);
+            }
+            root.Swap(estimate);
+        }
+
+        // Returns natural logarithm of value estimated by its top digits
+        static double Logarithm(const NumberType& value)
+        {
+            SizeType length = value.Length();
+            SizeType top = length < 3 ? length : 3;
+            double mantissa = 0;
+            for (IntType i = length - 1; i >= IntType(length - top); --i)
+            {
+                mantissa = mantissa * Base + value.GetDigit(i);
+            }
+            return std::log(mantissa) + (length - top) * std::log(double(Base));
+        }
+
+        static bool IsSmallPrime(UnsignedValueType number)
+        {
+            if (number < 2)
+            {
+                return false;
+            }
+            for (UnsignedValueType divisor = 2; divisor * divisor <= number; ++divisor)
+            {
+                if (number % divisor == 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static DigitType PowerModulo(DigitType number, UnsignedValueType exponent,
+            DigitType modulus)
+        {
+            DigitType result = 1 % modulus;
+            number %= modulus;
+            while (exponent > 0)
+            {
+                if (exponent & 1)
+                {
+                    result = result * number % modulus;
+                }
+                number = number * number % modulus;
+                exponent >>= 1;
+            }
+            return result;
+        }
+
+        // Returns integer next to estimate of degree-th root of value, whose degree-th
+        // power has the same lowest digit as value, or zero if there is none
+        static DigitType SmallRootCandidate(const NumberType& value, double estimate,
+            UnsignedValueType degree)
+        {
+            DigitType center = static_cast<DigitType>(estimate + 0.5);
+            for (DigitType candidate = center > 2 ? center - 1 : 2; candidate <= center + 1;
+                ++candidate)
+            {
+                if (PowerModulo(candidate, degree, Base) == value.GetDigit(0))
+                {
+                    return candidate;
+                }
+            }
+            return 0;
+        }
+
+        // Fast rejection of numbers which are not degree-th powers.
+        // For primes q = 1 (mod degree) a degree-th power is either divisible by q
+        // or its residue r satisfies r^((q - 1) / degree) = 1 (mod q)
+        static bool IsPowerResidue(const NumberType& value, UnsignedValueType degree)
+        {
+            const UnsignedValueType maxModulus = 1000000;
+            const int maxChecks = 4;
+            int checks = 0;
+            for (UnsignedValueType modulus = degree + 1;
+                modulus < maxModulus && checks < maxChecks;
+                modulus += degree)
+            {
+                if (!IsSmallPrime(modulus))
+                {
+                    continue;
+                }
+                ++checks;
+                DigitType residue = NumberType::SmallRemainder(value, modulus);
+                if (residue != 0 &&
+                    PowerModulo(residue, (modulus - 1) / degree, modulus) != 1)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
     private:
+        friend class LongPreparedDivisor<Traits, Base>;
+        friend class LongPreparedMultiplier<Traits, Base>;
+        friend class LongAccumulator<Traits, Base>;
+        friend class LongModularContext<Traits, Base>;
+        friend class LongDiskNumber<Traits, Base>;
+
         NumberType value_;
         SignType sign_;
     };
@@ -0,0 +1,344 @@
+#ifndef LONG_ARITHMETIC_LONG_MATRIX_H_
+#define LONG_ARITHMETIC_LONG_MATRIX_H_
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "long_rational.h"
+#include "long_residue_system.h"
+#include "thread_pool.h"
+
+namespace LongArithmetic
+{
+    // Dense matrices of integers with exact determinants and solutions of linear systems.
+    // Elimination is fraction-free (Bareiss), so entries stay integer minors of
+    // the matrix and never grow beyond the determinant. Determinants may also be found
+    // modulo many word-sized primes and reconstructed by Chinese remaindering.
+    // Rows of every elimination step and residues modulo different primes
+    // are computed in parallel
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongMatrix
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using RationalType = LongRational<Traits, Base>;
+        using ResidueSystemType = LongResidueSystem<Traits, Base>;
+        using SizeType = typename IntegerType::SizeType;
+        using ValueType = typename IntegerType::ValueType;
+        using DigitType = typename IntegerType::DigitType;
+
+        LongMatrix()
+            : rows_(0)
+            , columns_(0)
+        {}
+
+        // Creates zero matrix of given size
+        LongMatrix(SizeType rows, SizeType columns)
+            : rows_(rows)
+            , columns_(columns)
+            , entries_(std::size_t(rows) * columns, IntegerType(0))
+        {}
+
+        SizeType Rows() const
+        {
+            return rows_;
+        }
+
+        SizeType Columns() const
+        {
+            return columns_;
+        }
+
+        IntegerType& GetEntry(SizeType row, SizeType column)
+        {
+            return entries_[std::size_t(row) * columns_ + column];
+        }
+
+        const IntegerType& GetEntry(SizeType row, SizeType column) const
+        {
+            return entries_[std::size_t(row) * columns_ + column];
+        }
+
+        // Returns determinant of square matrix computed by fraction-free elimination
+        static IntegerType Determinant(const LongMatrix<Traits, Base>& matrix,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            CheckSquare(matrix);
+            if (matrix.rows_ == 0)
+            {
+                return IntegerType(1);
+            }
+            LongMatrix<Traits, Base> reduced(matrix);
+            bool negate = false;
+            if (!reduced.Eliminate(matrix.rows_, negate, pool))
+            {
+                return IntegerType(0);
+            }
+            IntegerType determinant(reduced.GetEntry(matrix.rows_ - 1, matrix.rows_ - 1));
+            if (negate)
+            {
+                IntegerType::Multiply(determinant, -1, determinant);
+            }
+            return determinant;
+        }
+
+        // Returns determinant of square matrix reconstructed from its residues
+        // modulo primes below 2^32, whose product exceeds twice the Hadamard bound
+        static IntegerType ModularDeterminant(const LongMatrix<Traits, Base>& matrix,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            CheckSquare(matrix);
+            if (matrix.rows_ == 0)
+            {
+                return IntegerType(1);
+            }
+            // |det| <= prod_i |row_i|, natural logarithm of the bound is accumulated
+            double bound = 0;
+            for (SizeType i = 0; i < matrix.rows_; ++i)
+            {
+                double rowMaximum = 0;
+                for (SizeType j = 0; j < matrix.columns_; ++j)
+                {
+                    rowMaximum = std::max(rowMaximum, Logarithm(matrix.GetEntry(i, j)));
+                }
+                bound += rowMaximum + 0.5 * std::log(double(matrix.columns_));
+            }
+            std::vector<DigitType> primes;
+            double modulusLogarithm = 0;
+            for (DigitType candidate = MaxPrime; modulusLogarithm <= bound + 1; candidate -= 2)
+            {
+                if (IsPrime(candidate))
+                {
+                    primes.push_back(candidate);
+                    modulusLogarithm += std::log(double(candidate));
+                }
+            }
+
+            // Entries are reduced modulo all primes at once by remainder trees
+            ResidueSystemType system(primes, pool);
+            std::vector<std::vector<DigitType>> entryResidues(matrix.entries_.size());
+            pool.ParallelFor(matrix.entries_.size(), [&](std::size_t i)
+            {
+                system.Reduce(matrix.entries_[i], entryResidues[i], pool);
+            });
+            std::vector<DigitType> residues(primes.size());
+            pool.ParallelFor(primes.size(), [&](std::size_t i)
+            {
+                residues[i] = DeterminantModulo(entryResidues, matrix.rows_, i, primes[i]);
+            });
+            IntegerType determinant;
+            system.Reconstruct(residues, determinant, true, pool);
+            return determinant;
+        }
+
+        // Returns solution x of matrix * x = rhs for nonsingular square matrix.
+        // Elimination and back substitution find integers det * x, which are
+        // reduced to fractions only at the end
+        static std::vector<RationalType> Solve(const LongMatrix<Traits, Base>& matrix,
+            const std::vector<IntegerType>& rhs,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            CheckSquare(matrix);
+            if (rhs.size() != matrix.rows_)
+            {
+                throw std::invalid_argument("Size of right-hand side differs from size of matrix");
+            }
+            SizeType size = matrix.rows_;
+            LongMatrix<Traits, Base> augmented(size, size + 1);
+            for (SizeType i = 0; i < size; ++i)
+            {
+                for (SizeType j = 0; j < size; ++j)
+                {
+                    augmented.GetEntry(i, j) = matrix.GetEntry(i, j);
+                }
+                augmented.GetEntry(i, size) = rhs[i];
+            }
+            bool negate = false;
+            if (size == 0)
+            {
+                return std::vector<RationalType>();
+            }
+            if (!augmented.Eliminate(size, negate, pool))
+            {
+                throw std::domain_error("Singular matrix");
+            }
+
+            // Row i of reduced system gives
+            // y_i = (d * b_i - sum_{j > i} a_ij * y_j) / a_ii for y = d * x,
+            // where d is the last pivot, and every quotient is exact
+            const IntegerType& determinant = augmented.GetEntry(size - 1, size - 1);
+            std::vector<IntegerType> scaled(size);
+            for (SizeType k = size; k-- > 0;)
+            {
+                IntegerType sum;
+                IntegerType::Multiply(determinant, augmented.GetEntry(k, size), sum);
+                for (SizeType j = k + 1; j < size; ++j)
+                {
+                    IntegerType::SubMul(augmented.GetEntry(k, j), scaled[j], sum);
+                }
+                IntegerType::DivideExact(sum, augmented.GetEntry(k, k), scaled[k]);
+            }
+
+            std::vector<RationalType> solution(size);
+            pool.ParallelFor(size, [&](std::size_t i)
+            {
+                solution[i] = RationalType(scaled[i], determinant);
+            });
+            return solution;
+        }
+
+    private:
+        // Largest prime below 2^32
+        static const DigitType MaxPrime = 4294967291ULL;
+
+        static void CheckSquare(const LongMatrix<Traits, Base>& matrix)
+        {
+            if (matrix.rows_ != matrix.columns_)
+            {
+                throw std::invalid_argument("Matrix is not square");
+            }
+        }
+
+        // Fraction-free elimination of the first steps columns.
+        // After step k entries below row k are minors of order k + 2 of the matrix,
+        // divided by previous pivot exactly. Rows are swapped to find nonzero pivots,
+        // negate is flipped on every swap. Returns false if a pivot is zero
+        bool Eliminate(SizeType steps, bool& negate, ThreadPool& pool)
+        {
+            IntegerType previous(1);
+            for (SizeType k = 0; k < steps; ++k)
+            {
+                SizeType pivotRow = k;
+                while (pivotRow < rows_ && GetEntry(pivotRow, k).IsZero())
+                {
+                    ++pivotRow;
+                }
+                if (pivotRow == rows_)
+                {
+                    return false;
+                }
+                if (pivotRow != k)
+                {
+                    for (SizeType j = 0; j < columns_; ++j)
+                    {
+                        GetEntry(k, j).Swap(GetEntry(pivotRow, j));
+                    }
+                    negate = !negate;
+                }
+                // a_ij = (a_kk * a_ij - a_ik * a_kj) / previous pivot
+                pool.ParallelFor(rows_ - k - 1, [&](std::size_t index)
+                {
+                    SizeType i = static_cast<SizeType>(k + 1 + index);
+                    IntegerType product;
+                    for (SizeType j = k + 1; j < columns_; ++j)
+                    {
+                        IntegerType::Multiply(GetEntry(k, k), GetEntry(i, j), product);
+                        IntegerType::SubMul(GetEntry(i, k), GetEntry(k, j), product);
+                        IntegerType::DivideExact(product, previous, GetEntry(i, j));
+                    }
+                    GetEntry(i, k) = IntegerType(0);
+                });
+                previous = GetEntry(k, k);
+            }
+            return true;
+        }
+
+        // Returns natural logarithm of absolute value of nonzero number
+        // estimated from above by its top digits, and zero for zero
+        static double Logarithm(const IntegerType& number)
+        {
+            if (number.IsZero())
+            {
+                return 0;
+            }
+            SizeType length = number.Length();
+            double mantissa = number.GetDigit(length - 1) + 1.0;
+            if (length > 1)
+            {
+                mantissa = (mantissa - 1) + (number.GetDigit(length - 2) + 1.0) / Base;
+            }
+            return std::log(mantissa) + (length - 1) * std::log(double(Base));
+        }
+
+        static bool IsPrime(DigitType number)
+        {
+            for (DigitType divisor = 3; divisor * divisor <= number; divisor += 2)
+            {
+                if (number % divisor == 0)
+                {
+                    return false;
+                }
+            }
+            return number % 2 != 0;
+        }
+
+        // Returns inverse of number modulo prime
+        static DigitType InverseModulo(DigitType number, DigitType prime)
+        {
+            DigitType result = 1;
+            for (DigitType exponent = prime - 2; exponent > 0; exponent >>= 1)
+            {
+                if (exponent & 1)
+                {
+                    result = result * number % prime;
+                }
+                number = number * number % prime;
+            }
+            return result;
+        }
+
+        // Returns determinant of matrix of given size modulo prime found by Gaussian
+        // elimination, where residues[i][index] is the residue of i-th entry modulo prime
+        static DigitType DeterminantModulo(const std::vector<std::vector<DigitType>>& residues,
+            SizeType size, std::size_t index, DigitType prime)
+        {
+            std::vector<DigitType> entries(std::size_t(size) * size);
+            for (std::size_t i = 0; i < entries.size(); ++i)
+            {
+                entries[i] = residues[i][index];
+            }
+            DigitType determinant = 1;
+            for (SizeType k = 0; k < size; ++k)
+            {
+                DigitType* pPivotRow = entries.data() + std::size_t(k) * size;
+                SizeType pivotRow = k;
+                while (pivotRow < size && entries[std::size_t(pivotRow) * size + k] == 0)
+                {
+                    ++pivotRow;
+                }
+                if (pivotRow == size)
+                {
+                    return 0;
+                }
+                if (pivotRow != k)
+                {
+                    std::swap_ranges(pPivotRow, pPivotRow + size,
+                        entries.data() + std::size_t(pivotRow) * size);
+                    determinant = prime - determinant;
+                }
+                determinant = determinant * pPivotRow[k] % prime;
+                DigitType inverse = InverseModulo(pPivotRow[k], prime);
+                for (SizeType i = k + 1; i < size; ++i)
+                {
+                    DigitType* pRow = entries.data() + std::size_t(i) * size;
+                    DigitType factor = pRow[k] * inverse % prime;
+                    for (SizeType j = k + 1; j < size; ++j)
+                    {
+                        pRow[j] = (pRow[j] + (prime - factor) * pPivotRow[j]) % prime;
+                    }
+                }
+            }
+            return determinant;
+        }
+
+    private:
+        SizeType rows_;
+        SizeType columns_;
+        std::vector<IntegerType> entries_;
+    };
+};
+
+#endif
@@ -0,0 +1,352 @@
+#ifndef LONG_ARITHMETIC_LONG_MODULAR_CONTEXT_H_
+#define LONG_ARITHMETIC_LONG_MODULAR_CONTEXT_H_
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "long_integer.h"
+
+namespace LongArithmetic
+{
+    // Arithmetic modulo odd number coprime with Base in Montgomery form.
+    // Residues are kept as digits of fixed length of modulus multiplied by
+    // R = Base^length, so products are reduced by multiplications and shifts
+    // of digits without long division. Operations write into existing residues
+    // and use scratch memory of context, so they allocate nothing, except that
+    // FromResidue grows result integers shorter than modulus.
+    // Context is not thread-safe, concurrent computations need own contexts
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongModularContext
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using NumberType = LongNumber<Traits, Base>;
+        using StorageType = typename NumberType::StorageType;
+        using DigitType = typename NumberType::DigitType;
+        using SizeType = typename NumberType::SizeType;
+        using ResidueType = std::vector<StorageType>;
+
+        explicit LongModularContext(const IntegerType& modulus)
+            : modulus_(modulus)
+            , length_(modulus.Length())
+            , digits_(length_)
+            , scratch_(length_ + 1)
+            , one_(length_)
+            , square_(length_)
+            , chunk_(length_)
+            , power_(length_)
+        {
+            if (modulus.Sign() < 0 || modulus.IsZero())
+            {
+                throw std::domain_error("Modulus of Montgomery arithmetic must be positive");
+            }
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                digits_[i] = static_cast<StorageType>(modulus.GetDigit(i));
+            }
+            inverse_ = NegatedInverse(digits_[0]);
+
+            // R mod modulus and R^2 mod modulus
+            IntegerType power, remainder;
+            IntegerType::ShiftLeft(IntegerType(1), length_, power);
+            IntegerType::Mod(power, modulus_, remainder);
+            Load(remainder, one_);
+            IntegerType::ShiftLeft(IntegerType(1), 2 * length_, power);
+            IntegerType::Mod(power, modulus_, remainder);
+            Load(remainder, square_);
+        }
+
+        const IntegerType& Modulus() const
+        {
+            return modulus_;
+        }
+
+        // Returns zero residue of suitable length
+        ResidueType Residue() const
+        {
+            return ResidueType(length_, 0);
+        }
+
+        // Residue of one
+        const ResidueType& One() const
+        {
+            return one_;
+        }
+
+        // Function writes residue of number into result.
+        // Chunks of length digits of number are added from the highest one
+        // by Horner's scheme, product of chunk and R^2 is its residue
+        void ToResidue(const IntegerType& number, ResidueType& result)
+        {
+            std::fill(result.begin(), result.end(), 0);
+            SizeType chunks = (number.Length() + length_ - 1) / length_;
+            for (SizeType k = chunks; k-- > 0;)
+            {
+                Multiply(result, square_, result);
+                for (SizeType i = 0; i < length_; ++i)
+                {
+                    SizeType index = k * length_ + i;
+                    chunk_[i] = index < number.Length() ?
+                        static_cast<StorageType>(number.GetDigit(index)) : 0;
+                }
+                Multiply(chunk_, square_, chunk_);
+                Add(result, chunk_, result);
+            }
+            if (number.Sign() < 0)
+            {
+                std::fill(chunk_.begin(), chunk_.end(), 0);
+                Subtract(chunk_, result, result);
+            }
+        }
+
+        // Function writes number in [0, modulus) with given residue into result
+        void FromResidue(const ResidueType& residue, IntegerType& result)
+        {
+            std::fill(chunk_.begin(), chunk_.end(), 0);
+            chunk_[0] = 1;
+            Multiply(residue, chunk_, chunk_);
+            result.value_.Reserve(length_);
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                result.value_.GetDigit(i) = chunk_[i];
+            }
+            result.value_.Length() = length_;
+            result.value_.Trim();
+            result.sign_ = 1;
+        }
+
+        // Function writes lhs * rhs into result, result may be an operand
+        void Multiply(const ResidueType& lhs, const ResidueType& rhs, ResidueType& result)
+        {
+            // Digits of lhs are added one by one together with a multiple of modulus,
+            // which makes the lowest digit zero, so every step divides the sum by Base
+            DigitType* pScratch = scratch_.data();
+            std::fill(scratch_.begin(), scratch_.end(), 0);
+            const StorageType* pRhs = rhs.data();
+            const StorageType* pModulus = digits_.data();
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                DigitType digit = lhs[i];
+                DigitType value = pScratch[0] + digit * pRhs[0];
+                DigitType factor = value % Base * inverse_ % Base;
+                DigitType carry = (value + factor * pModulus[0]) / Base;
+                for (SizeType j = 1; j < length_; ++j)
+                {
+                    value = pScratch[j] + digit * pRhs[j] + factor * pModulus[j] + carry;
+                    carry = value / Base;
+                    pScratch[j - 1] = value - carry * Base;
+                }
+                value = pScratch[length_] + carry;
+                pScratch[length_ - 1] = value % Base;
+                pScratch[length_] = value / Base;
+            }
+            // Sum is less than twice modulus
+            if (pScratch[length_] != 0 || CompareModulus(pScratch) >= 0)
+            {
+                SubtractModulus(pScratch);
+            }
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                result[i] = static_cast<StorageType>(pScratch[i]);
+            }
+        }
+
+        // Function writes lhs + rhs into result, result may be an operand
+        void Add(const ResidueType& lhs, const ResidueType& rhs, ResidueType& result)
+        {
+            DigitType* pScratch = scratch_.data();
+            DigitType carry = 0;
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                DigitType value = DigitType(lhs[i]) + rhs[i] + carry;
+                carry = value >= Base ? 1 : 0;
+                pScratch[i] = value - carry * Base;
+            }
+            pScratch[length_] = carry;
+            if (carry != 0 || CompareModulus(pScratch) >= 0)
+            {
+                SubtractModulus(pScratch);
+            }
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                result[i] = static_cast<StorageType>(pScratch[i]);
+            }
+        }
+
+        // Function writes lhs - rhs into result, result may be an operand
+        void Subtract(const ResidueType& lhs, const ResidueType& rhs, ResidueType& result)
+        {
+            DigitType borrow = 0;
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                DigitType subtrahend = DigitType(rhs[i]) + borrow;
+                borrow = lhs[i] < subtrahend ? 1 : 0;
+                result[i] = static_cast<StorageType>(lhs[i] + borrow * Base - subtrahend);
+            }
+            if (borrow != 0)
+            {
+                // Adding modulus cancels the borrow
+                DigitType carry = 0;
+                for (SizeType i = 0; i < length_; ++i)
+                {
+                    DigitType value = DigitType(result[i]) + digits_[i] + carry;
+                    carry = value >= Base ? 1 : 0;
+                    result[i] = static_cast<StorageType>(value - carry * Base);
+                }
+            }
+        }
+
+        // Function writes residue / 2 into result, result may be residue
+        void Half(const ResidueType& residue, ResidueType& result)
+        {
+            // Odd residues are made even by addition of odd modulus
+            DigitType* pScratch = scratch_.data();
+            DigitType carry = 0;
+            bool odd = residue[0] % 2 != 0;
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                DigitType value = DigitType(residue[i]) + (odd ? digits_[i] : 0) + carry;
+                carry = value >= Base ? 1 : 0;
+                pScratch[i] = value - carry * Base;
+            }
+            DigitType remainder = carry;
+            for (SizeType i = length_; i-- > 0;)
+            {
+                DigitType value = remainder * Base + pScratch[i];
+                result[i] = static_cast<StorageType>(value / 2);
+                remainder = value % 2;
+            }
+        }
+
+        // Function writes base^exponent into result, where bits of exponent
+        // are given from the lowest one
+        void Power(const ResidueType& base, const std::vector<bool>& bits, ResidueType& result)
+        {
+            // Base is kept apart, since result may be base
+            std::copy(base.begin(), base.end(), power_.begin());
+            std::copy(one_.begin(), one_.end(), result.begin());
+            for (std::size_t i = bits.size(); i-- > 0;)
+            {
+                Multiply(result, result, result);
+                if (bits[i])
+                {
+                    Multiply(result, power_, result);
+                }
+            }
+        }
+
+        static bool IsZero(const ResidueType& residue)
+        {
+            for (StorageType digit : residue)
+            {
+                if (digit != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool Equal(const ResidueType& lhs, const ResidueType& rhs)
+        {
+            return lhs == rhs;
+        }
+
+        // Returns bits of non-negative number from the lowest one
+        static std::vector<bool> Bits(const IntegerType& number)
+        {
+            const DigitType chunk = DigitType(1) << 16;
+            std::vector<bool> bits;
+            IntegerType rest(number), quotient;
+            while (!rest.IsZero())
+            {
+                DigitType surplus;
+                IntegerType::SmallDivide(rest, chunk, quotient, surplus);
+                for (int i = 0; i < 16; ++i)
+                {
+                    bits.push_back((surplus >> i) & 1);
+                }
+                rest.Swap(quotient);
+            }
+            while (!bits.empty() && !bits.back())
+            {
+                bits.pop_back();
+            }
+            return bits;
+        }
+
+    private:
+        // Returns -1 / digit modulo Base
+        static DigitType NegatedInverse(DigitType digit)
+        {
+            using SignedType = typename NumberType::IntType;
+            SignedType previous = 0, current = 1;
+            DigitType lhs = Base, rhs = digit;
+            while (rhs != 0)
+            {
+                DigitType quotient = lhs / rhs;
+                SignedType next = previous - SignedType(quotient) * current;
+                previous = current;
+                current = next;
+                DigitType remainder = lhs % rhs;
+                lhs = rhs;
+                rhs = remainder;
+            }
+            if (lhs != 1)
+            {
+                throw std::domain_error("Modulus of Montgomery arithmetic must be coprime with base");
+            }
+            DigitType inverse = previous < 0 ? DigitType(previous + SignedType(Base)) : DigitType(previous);
+            return inverse == 0 ? 0 : Base - inverse;
+        }
+
+        // Writes digits of number less than modulus into residue
+        void Load(const IntegerType& number, ResidueType& residue) const
+        {
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                residue[i] = i < number.Length() ? static_cast<StorageType>(number.GetDigit(i)) : 0;
+            }
+        }
+
+        // Compares the lowest length digits of value with modulus
+        int CompareModulus(const DigitType* pValue) const
+        {
+            for (SizeType i = length_; i-- > 0;)
+            {
+                if (pValue[i] != digits_[i])
+                {
+                    return pValue[i] < digits_[i] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        // Subtracts modulus from value of length + 1 digits
+        void SubtractModulus(DigitType* pValue) const
+        {
+            DigitType borrow = 0;
+            for (SizeType i = 0; i < length_; ++i)
+            {
+                DigitType subtrahend = DigitType(digits_[i]) + borrow;
+                borrow = pValue[i] < subtrahend ? 1 : 0;
+                pValue[i] = pValue[i] + borrow * Base - subtrahend;
+            }
+            pValue[length_] -= borrow;
+        }
+
+    private:
+        IntegerType modulus_;
+        SizeType length_;
+        ResidueType digits_;
+        std::vector<DigitType> scratch_;
+        ResidueType one_;
+        ResidueType square_;
+        ResidueType chunk_;
+        ResidueType power_;
+        DigitType inverse_;
+    };
+};
+
+#endif
@@ -1,16 +1,25 @@
 #ifndef LONG_ARITHMETIC_LONG_NUMBER_H_
 #define LONG_ARITHMETIC_LONG_NUMBER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
 #include <limits>
+#include <new>
 #include <stdexcept>
 #include <sstream>
+#include <utility>
 
 #include "long_arithmetic_traits.h"
+#include "long_transform.h"
 
 namespace LongArithmetic
 {
-    // Natural numbers of arbitrary size
+    // Natural numbers of arbitrary size.
+    // If Traits::CopyOnWrite is set, copies share digits until one of them is modified.
     template <typename Traits, typename Traits::BaseType Base>
     class LongNumber
     {
@@ -18,9 +27,14 @@ namespace LongArithmetic
         using DigitType = typename Traits::DigitType;
         using ValueType = typename Traits::ValueType;
         using UnsignedValueType = typename Traits::UnsignedValueType;
+        using WideValueType = typename Traits::WideValueType;
+        using StorageType = typename Traits::StorageType;
         using SizeType = typename Traits::SizeType;
         using IntType = typename Traits::IntType;
         using BaseType = typename Traits::BaseType;
+        using TransformType = typename LongTransform<Traits>::TransformType;
+
+        static const bool CopyOnWrite = Traits::CopyOnWrite;
 
         static_assert(std::numeric_limits<ValueType>::is_signed
             &&  std::numeric_limits<ValueType>::is_integer
@@ -41,11 +55,14 @@ namespace LongArithmetic
             && (std::numeric_limits<DigitType>::digits >=
             2 * std::numeric_limits<BaseType>::digits),
             "Wrong configuration for long arithmetics");
+        static_assert(!std::numeric_limits<StorageType>::is_signed
+            && std::numeric_limits<StorageType>::is_integer
+            && Base - 1 <= std::numeric_limits<StorageType>::max(),
+            "Digits of Base do not fit into storage type");
 
         LongNumber()
             : coefficients_(0)
             , length_(1)
-            , base_(Base)
         {
             SizeType defaultSize = 8;
             Allocate(defaultSize);
@@ -54,14 +71,12 @@ namespace LongArithmetic
 
         explicit LongNumber(UnsignedValueType integer)
             : coefficients_(0)
-            , base_(Base)
         {
             CreateNumber(integer);
         }
 
         LongNumber(UnsignedValueType integer, SizeType integerSize)
             : coefficients_(0)
-            , base_(Base)
         {
             CreateNumber(integer, integerSize);
         }
@@ -69,36 +84,66 @@ namespace LongArithmetic
         LongNumber(const LongNumber<Traits, Base>& number)
             : coefficients_(0)
             , length_(number.length_)
-            , base_(number.base_)
         {
+            if (CopyOnWrite)
+            {
+                Share(number);
+                return;
+            }
             Allocate(number.size_);
-            const DigitType* ptrNumber = number.coefficients_;
+            const StorageType* ptrNumber = number.coefficients_;
             for (IntType i = 0; i < length_; ++i)
             {
                 coefficients_[i] = ptrNumber[i];
             }
         }
 
+        // Takes data of number leaving it suitable only for assignment and destruction
+        LongNumber(LongNumber<Traits, Base>&& number) noexcept
+            : coefficients_(number.coefficients_)
+            , length_(number.length_)
+            , size_(number.size_)
+        {
+            number.coefficients_ = 0;
+            number.length_ = 0;
+            number.size_ = 0;
+        }
+
         LongNumber<Traits, Base>& operator = (const LongNumber<Traits, Base>& number)
         {
             if (this != std::addressof(number))
             {
+                if (CopyOnWrite)
+                {
+                    if (coefficients_ != number.coefficients_)
+                    {
+                        Deallocate();
+                        Share(number);
+                    }
+                    length_ = number.length_;
+                    return *this;
+                }
                 if (size_ < number.length_)
                 {
                     Deallocate();
                     Allocate(number.length_);
                 }
                 length_ = number.length_;
-                const DigitType *ptrNumber = number.coefficients_;
+                const StorageType* ptrNumber = number.coefficients_;
                 for (SizeType i = 0; i < length_; ++i)
                 {
                     coefficients_[i] = ptrNumber[i];
                 }
-                base_ = number.base_;
             }
             return *this;
         }
 
+        LongNumber<Traits, Base>& operator = (LongNumber<Traits, Base>&& number) noexcept
+        {
+            Swap(number);
+            return *this;
+        }
+
         static int Compare(const LongNumber<Traits, Base>& lhs,
             const LongNumber<Traits, Base>& rhs)
         {
@@ -111,8 +156,8 @@ namespace LongArithmetic
                 return -1;
             }
 
-            const DigitType* pRight = rhs.coefficients_;
-            const DigitType* pLeft = lhs.coefficients_;
+            const StorageType* pRight = rhs.coefficients_;
+            const StorageType* pLeft = lhs.coefficients_;
             for (IntType i = lhs.length_ - 1; i >= 0; --i)
             {
                 if (pLeft[i] > pRight[i])
@@ -142,7 +187,13 @@ namespace LongArithmetic
             return size_;
         }
 
-        DigitType& GetDigit(IntType i)
+        StorageType& GetDigit(IntType i)
+        {
+            Detach();
+            return coefficients_[i];
+        }
+
+        DigitType GetDigit(IntType i) const
         {
             return coefficients_[i];
         }
@@ -153,19 +204,20 @@ namespace LongArithmetic
             const LongNumber<Traits, Base>& summand,
             LongNumber<Traits, Base>& result)
         {
+            result.Detach();
             IntType i;
             IntType temp, carry = 0;
-            const DigitType* pNumber = number.coefficients_;
-            const DigitType* pSummand = summand.coefficients_;
+            const StorageType* pNumber = number.coefficients_;
+            const StorageType* pSummand = summand.coefficients_;
             if (number.length_ < summand.length_)
             {
                 Add(summand, number, result);
                 return;
             }
-            DigitType* pResult = result.coefficients_;
+            StorageType* pResult = result.coefficients_;
             for (i = 0; i < summand.length_; ++i)
             {
-                temp = pNumber[i] + pSummand[i] + carry;
+                temp = carry + pNumber[i] + pSummand[i];
                 if (temp >= Base)
                 {
                     pResult[i] = temp - Base;
@@ -208,9 +260,10 @@ namespace LongArithmetic
             const LongNumber<Traits, Base>& subtrahend,
             LongNumber<Traits, Base>& result)
         {
-            const DigitType* pNumber = number.coefficients_;
-            const DigitType* pSubtrahend = subtrahend.coefficients_;
-            DigitType* pResult = result.coefficients_;
+            result.Detach();
+            const StorageType* pNumber = number.coefficients_;
+            const StorageType* pSubtrahend = subtrahend.coefficients_;
+            StorageType* pResult = result.coefficients_;
             IntType i;
             IntType temp, carry = 0;
             for (i = 0; i < subtrahend.length_; ++i)
@@ -257,19 +310,55 @@ namespace LongArithmetic
         static void Multiply(const LongNumber<Traits, Base>& number,
             const LongNumber<Traits, Base>& multiplier,
             LongNumber<Traits, Base>& result)
+        {
+            if (UsesTransform(number.length_, multiplier.length_, &number == &multiplier))
+            {
+                TransformMultiply(number, multiplier, result);
+            }
+            else
+            {
+                SchoolbookMultiply(number, multiplier, result);
+            }
+        }
+
+        // Function writes product of number and multiplier computed by transform
+        // into result, transform must be applicable to lengths of factors
+        // Note that memory allocated for result must suffice for calculation
+        static void TransformMultiply(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& multiplier,
+            LongNumber<Traits, Base>& result)
+        {
+            SizeType size = TransformSize(number.length_, multiplier.length_);
+            TransformType values, transformed;
+            Transform(number, size, values);
+            if (&number != &multiplier)
+            {
+                Transform(multiplier, size, transformed);
+            }
+            LongTransform<Traits>::PointwiseMultiply(values,
+                &number != &multiplier ? transformed : values);
+            FromTransform(values, number.length_ + multiplier.length_, false, result);
+        }
+
+        // Function writes product of number and multiplier computed digit by digit
+        // into result
+        // Note that memory allocated for result must suffice for calculation
+        static void SchoolbookMultiply(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& multiplier,
+            LongNumber<Traits, Base>& result)
         {
             IntType i, j;
             IntType carry, temp;
-            const DigitType* pNumber = number.coefficients_;
-            const DigitType* pMultiplier = multiplier.coefficients_;
-            DigitType* pResult = result.coefficients_;
             result.MakeZero();
+            const StorageType* pNumber = number.coefficients_;
+            const StorageType* pMultiplier = multiplier.coefficients_;
+            StorageType* pResult = result.coefficients_;
             for (i = 0; i < number.length_; ++i)
             {
                 carry = 0;
                 for (j = 0; j < multiplier.length_; ++j)
                 {
-                    temp = pNumber[i] * pMultiplier[j] + pResult[i + j] + carry;
+                    temp = DigitType(pNumber[i]) * pMultiplier[j] + pResult[i + j] + carry;
                     carry = temp / Base;
                     pResult[i + j] = temp - Base * carry;
                 }
@@ -283,249 +372,1272 @@ namespace LongArithmetic
             result.length_ = static_cast<SizeType>(i + 1);
         }
 
-        // Function writes result of division of number over divisor into result.
-        // Note that memory allocated for result must suffice for calculation.
-        static void Divide(const LongNumber<Traits, Base>& number,
-            const LongNumber<Traits, Base>& divisor,
-            LongNumber<Traits, Base>& result,
-            LongNumber<Traits, Base>& surplus)
+        // Function adds product of number and multiplier to result
+        // Note that
+        // Memory allocated for result must suffice for calculation
+        // Result must not be number or multiplier
+        static void AddMul(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& multiplier,
+            LongNumber<Traits, Base>& result)
         {
-            if (number.length_ < divisor.length_)
+            if (UsesTransform(number.length_, multiplier.length_))
             {
-                result.MakeZero();
-                surplus = number;
+                SizeType size = TransformSize(number.length_, multiplier.length_);
+                TransformType values, transformed;
+                Transform(number, size, values);
+                Transform(multiplier, size, transformed);
+                LongTransform<Traits>::PointwiseMultiply(values, transformed);
+                FromTransform(values, number.length_ + multiplier.length_, true, result);
                 return;
             }
-            if (divisor.length_ == 1)
+            result.Detach();
+            IntType length = std::max(result.length_, number.length_ + multiplier.length_) + 1;
+            StorageType* pResult = result.coefficients_;
+            for (IntType i = result.length_; i < length; ++i)
             {
-                SmallDivide(number, divisor.coefficients_[0],
-                    result, surplus.coefficients_[0]);
-                surplus.length_ = 1;
-                return;
+                pResult[i] = 0;
             }
-
-            IntType i;
-            LongNumber<Traits, Base> numberCopy(0, number.length_ + 1);
-            for (i = 0; i < number.length_; ++i)
-                numberCopy.coefficients_[i] = number.coefficients_[i];
-            numberCopy.coefficients_[number.length_] = 0;
-            numberCopy.length_ = number.length_;
-
-            LongNumber<Traits, Base>* ptrDivisor = (LongNumber<Traits, Base>*)(&divisor);
-
-            const DigitType* pDivisor = divisor.coefficients_;
-            DigitType* pNumberCopy = numberCopy.coefficients_;
-            DigitType* pResult = result.coefficients_;
-
-            IntType diffLength = number.length_ - divisor.length_;
-
-            IntType numberCopyCounter, resultShift;
-            DigitType* numberCopyShift;
-            IntType tempValue, storageValue, temp;
-            IntType factorGuess, helpValue;
-            IntType borrow, carry;
-
-            DigitType scale = Base / (pDivisor[divisor.length_ - 1] + 1);
-            if (scale > 1)
+            const StorageType* pNumber = number.coefficients_;
+            const StorageType* pMultiplier = multiplier.coefficients_;
+            for (IntType i = 0; i < number.length_; ++i)
             {
-                SmallMultiply(numberCopy, scale, numberCopy);
-                SmallMultiply(*ptrDivisor, scale, *ptrDivisor);
+                DigitType carry = 0, temp;
+                IntType j;
+                for (j = 0; j < multiplier.length_; ++j)
+                {
+                    temp = DigitType(pNumber[i]) * pMultiplier[j] + pResult[i + j] + carry;
+                    carry = temp / Base;
+                    pResult[i + j] = temp - carry * Base;
+                }
+                for (j += i; carry > 0; ++j)
+                {
+                    temp = pResult[j] + carry;
+                    carry = temp / Base;
+                    pResult[j] = temp - carry * Base;
+                }
             }
+            result.length_ = static_cast<SizeType>(length);
+            result.Trim();
+        }
 
-            for (resultShift = diffLength, numberCopyCounter = divisor.length_ + resultShift;
-                resultShift >= 0;
-                --resultShift, --numberCopyCounter)
+        // Function subtracts product of number and multiplier from result
+        // and returns true if the product exceeds result, in which case
+        // result holds the absolute value of the difference
+        // Note that
+        // Memory allocated for result must suffice for calculation
+        // Result must not be number or multiplier
+        static bool SubMul(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& multiplier,
+            LongNumber<Traits, Base>& result)
+        {
+            IntType length = std::max<IntType>(result.length_,
+                number.length_ + multiplier.length_);
+            if (UsesTransform(number.length_, multiplier.length_))
             {
-                factorGuess = (pNumberCopy[numberCopyCounter] * Base +
-                    pNumberCopy[numberCopyCounter - 1]) / pDivisor[divisor.length_ - 1];
-                helpValue = (pNumberCopy[numberCopyCounter] * Base +
-                    pNumberCopy[numberCopyCounter - 1]) % pDivisor[divisor.length_ - 1];
-                while (helpValue < Base)
+                SizeType size = TransformSize(number.length_, multiplier.length_);
+                TransformType values, transformed;
+                Transform(number, size, values);
+                Transform(multiplier, size, transformed);
+                LongTransform<Traits>::PointwiseMultiply(values, transformed);
+                return SubtractTransform(values, number.length_ + multiplier.length_, result);
+            }
+            result.Detach();
+            StorageType* pResult = result.coefficients_;
+            for (IntType i = result.length_; i < length; ++i)
+            {
+                pResult[i] = 0;
+            }
+            const StorageType* pNumber = number.coefficients_;
+            const StorageType* pMultiplier = multiplier.coefficients_;
+            // Borrow out of the top digit means that the difference is negative
+            // and result holds Base^length plus the difference
+            bool negative = false;
+            for (IntType i = 0; i < number.length_; ++i)
+            {
+                DigitType carry = 0, temp, digit;
+                IntType j;
+                for (j = 0; j < multiplier.length_; ++j)
                 {
-                    storageValue = pDivisor[divisor.length_ - 2] * factorGuess;
-                    tempValue = helpValue * Base + pNumberCopy[numberCopyCounter - 2];
-                    if ((storageValue > tempValue) || (factorGuess == Base))
+                    temp = DigitType(pNumber[i]) * pMultiplier[j] + carry;
+                    carry = temp / Base;
+                    digit = temp - carry * Base;
+                    if (pResult[i + j] >= digit)
                     {
-                        --factorGuess;
-                        helpValue += pDivisor[divisor.length_ - 1];
+                        pResult[i + j] -= digit;
                     }
                     else
                     {
-                        break;
+                        pResult[i + j] += Base - digit;
+                        ++carry;
                     }
                 }
-                carry = 0;
-                borrow = 0;
-                numberCopyShift = pNumberCopy + resultShift;
-                for (i = 0; i < divisor.length_; ++i)
+                for (j += i; carry > 0 && j < length; ++j)
                 {
-                    tempValue = pDivisor[i] * factorGuess + carry;
-                    carry = tempValue / Base;
-                    tempValue -= carry * Base;
-                    storageValue = numberCopyShift[i] - tempValue + borrow;
-                    if (storageValue < 0)
+                    if (pResult[j] >= carry)
                     {
-                        numberCopyShift[i] = storageValue + Base;
-                        borrow = -1;
+                        pResult[j] -= carry;
+                        carry = 0;
                     }
                     else
                     {
-                        numberCopyShift[i] = storageValue;
-                        borrow = 0;
-                    }
-                }
-                storageValue = numberCopyShift[i] - carry + borrow;
-                if (storageValue < 0)
-                {
-                    numberCopyShift[i] = storageValue + Base;
-                    borrow = -1;
-                }
-                else
-                {
-                    numberCopyShift[i] = storageValue;
-                    borrow = 0;
-                }
-                if (borrow == 0)
-                {
-                    pResult[resultShift] = factorGuess;
-                }
-                else
-                {
-                    pResult[resultShift] = factorGuess - 1;
-                    carry = 0;
-                    for (i = 0; i < divisor.length_; ++i)
-                    {
-                        temp = numberCopyShift[i] + pDivisor[i] + carry;
-                        if (temp >= Base)
-                        {
-                            numberCopyShift[i] = temp - Base;
-                            carry = 1;
-                        }
-                        else
-                        {
-                            numberCopyShift[i] = temp;
-                            carry = 0;
-                        }
+                        pResult[j] += Base - carry;
+                        carry = 1;
                     }
-                    numberCopyShift[i] = numberCopyShift[i] + carry - Base;
-                }
-                i = numberCopy.length_ - 1;
-                while (i > 0 && pNumberCopy[i] == 0)
-                {
-                    --i;
                 }
-                numberCopy.length_ = static_cast<SizeType>(i + 1);
+                negative |= carry > 0;
             }
-            while (diffLength > 0 && pResult[diffLength] == 0)
+            result.length_ = static_cast<SizeType>(length);
+            if (negative)
             {
-                diffLength--;
+                Complement(result);
             }
+            result.Trim();
+            return negative;
+        }
 
-            result.length_ = static_cast<SizeType>(diffLength + 1);
-            if (scale > 1)
+        // Tells whether product of numbers of given lengths is computed by transform,
+        // square tells whether the numbers are the same
+        static bool UsesTransform(SizeType numberLength, SizeType multiplierLength,
+            bool square = false)
+        {
+            SizeType threshold = square ?
+                TransformSquareThreshold() : TransformMultiplyThreshold();
+            return std::min(numberLength, multiplierLength) >= threshold &&
+                TransformApplies(numberLength, multiplierLength);
+        }
+
+        // Square root of Base if Base is a square, otherwise zero
+        static constexpr DigitType HalfBase()
+        {
+            DigitType root = 1;
+            while ((root + 1) * (root + 1) <= Base)
             {
-                DigitType junk = 0;
-                SmallDivide(*ptrDivisor, scale, *ptrDivisor, junk);
-                SmallDivide(numberCopy, scale, surplus, junk);
+                ++root;
             }
-            else
+            return root * root == Base ? root : 0;
+        }
+
+        // Tells whether product of numbers of given lengths can be computed by transform
+        static bool TransformApplies(SizeType numberLength, SizeType multiplierLength)
+        {
+            constexpr DigitType halfBase = HalfBase();
+            SizeType length = std::min(numberLength, multiplierLength);
+            return halfBase != 0 &&
+                WideValueType(2 * length) * (halfBase - 1) * (halfBase - 1) <
+                LongTransform<Traits>::Modulus;
+        }
+
+        // Size of transforms used for product of numbers of given lengths
+        static SizeType TransformSize(SizeType numberLength, SizeType multiplierLength)
+        {
+            return LongTransform<Traits>::Size(2 * (numberLength + multiplierLength));
+        }
+
+        // Function writes transform of given size of halves of digits of number
+        // into result
+        static void Transform(const LongNumber<Traits, Base>& number,
+            SizeType size,
+            TransformType& result)
+        {
+            constexpr DigitType halfBase = HalfBase();
+            result.assign(size, 0);
+            for (IntType i = 0; i < number.length_; ++i)
             {
-                surplus = numberCopy;
+                result[2 * i] = number.coefficients_[i] % halfBase;
+                result[2 * i + 1] = number.coefficients_[i] / halfBase;
             }
+            LongTransform<Traits>::Forward(result);
         }
 
-        // Function writes product of number and numeral into result
+        // Function writes product of number and multiplier of given length
+        // into result, where transformed is the transform of multiplier
         // Note that memory allocated for result must suffice for calculation
-        static void SmallMultiply(const LongNumber<Traits, Base>& number,
-            const DigitType numeral,
+        static void MultiplyTransformed(const LongNumber<Traits, Base>& number,
+            const TransformType& transformed,
+            SizeType multiplierLength,
             LongNumber<Traits, Base>& result)
         {
-            IntType i;
-            IntType temp, carry = 0;
-            const DigitType* pNumber = number.coefficients_;
-            DigitType *pResult = result.coefficients_;
-            for (i = 0; i < number.length_; ++i)
-            {
-                temp = pNumber[i] * numeral + carry;
-                carry = temp / Base;
-                pResult[i] = temp - carry * Base;
-            }
-            if (carry)
-            {
-                pResult[i] = carry;
-                result.length_ = number.length_ + 1;
-            }
-            else
-                result.length_ = number.length_;
+            TransformType values;
+            Transform(number, static_cast<SizeType>(transformed.size()), values);
+            LongTransform<Traits>::PointwiseMultiply(values, transformed);
+            FromTransform(values, number.length_ + multiplierLength, false, result);
         }
 
-        // Function writes result of division of number over numeral into result
-        // Note that memory allocated for result must suffice for calculation
-        static void SmallDivide(const LongNumber<Traits, Base>& number,
-            const DigitType numeral,
+        // Function writes result of division of number over divisor into result.
+        // Note that memory allocated for result must suffice for calculation.
+        static void Divide(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& divisor,
             LongNumber<Traits, Base>& result,
-            DigitType& surplus)
+            LongNumber<Traits, Base>& surplus)
         {
-            IntType r = 0, temp;
-            const DigitType* pNumber = number.coefficients_;
-            DigitType* pResult = result.coefficients_;
-            IntType i;
-            for (i = number.length_ - 1; i >= 0; --i)
+            DivideCore(number, divisor, &result, &surplus);
+        }
+
+        // Function writes quotient of number over divisor into result
+        // without computation of remainder
+        static void Divide(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& divisor,
+            LongNumber<Traits, Base>& result)
+        {
+            DivideCore(number, divisor, &result, 0);
+        }
+
+        // Function writes remainder of division of number over divisor into surplus
+        // without storage of quotient
+        static void Mod(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& divisor,
+            LongNumber<Traits, Base>& surplus)
+        {
+            DivideCore(number, divisor, 0, &surplus);
+        }
+
+        // Function writes quotient of number over divisor into result,
+        // number must be divisible by divisor.
+        // Digits of quotient are found from the lowest ones by multiplication
+        // with inverse of the lowest digit of divisor modulo Base (Jebelean's method),
+        // only digits of number below the length of quotient are updated.
+        // Note that memory allocated for result must suffice for calculation
+        static void DivideExact(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& divisor,
+            LongNumber<Traits, Base>& result)
+        {
+            DigitType junk;
+            if (divisor.length_ == 1)
             {
-                temp = r * Base + pNumber[i];
-                pResult[i] = temp / numeral;
-                r = temp - pResult[i] * numeral;
+                SmallDivide(number, divisor.coefficients_[0], result, junk);
+                return;
             }
-            surplus = r;
-            i = number.length_ - 1;
-            while (i > 0 && pResult[i] == 0)
+            if (number.length_ < divisor.length_)
             {
-                --i;
+                result.MakeZero();
+                return;
             }
-            result.length_ = static_cast<SizeType>(i + 1);
-        }
 
-        // Reads number from stream istr, validate it and converts to inner format
-        friend std::istream& operator >> (std::istream& istr,
-            LongNumber<Traits, Base>& number)
-        {
-            LongNumber<Traits, DECIMAL_BASE> decimalNumber;
-            bool valid = true;
-            decimalNumber.length() = 0;
-
-            std::string numberString;
-            istr >> numberString;
+            // Zero digits of divisor are matched by zero digits of number
+            SizeType zeros = 0;
+            while (divisor.coefficients_[zeros] == 0)
+            {
+                ++zeros;
+            }
+            LongNumber<Traits, Base> dividend(0, number.length_ - zeros);
+            ShiftRight(number, zeros, dividend);
+            LongNumber<Traits, Base> exactDivisor(0, divisor.length_ - zeros);
+            ShiftRight(divisor, zeros, exactDivisor);
 
-            decimalNumber.allocate(numberString.size());
-            for (IntType i = 0; i < numberString.size(); ++i)
+            // Lowest digit of divisor must be coprime with Base.
+            // Common factors of divisor and Base divide both numbers,
+            // so they are removed until none is left
+            while (true)
             {
-                char symbol = numberString[i];
-                if ('0' <= symbol && symbol <= '9')
-                {
-                    decimalNumber.GetDigit(i) = symbol - '0';
-                }
-                else
+                DigitType factor = BaseFactor(exactDivisor);
+                if (factor == 1)
                 {
-                    valid = false;
                     break;
                 }
+                SmallDivide(dividend, factor, dividend, junk);
+                SmallDivide(exactDivisor, factor, exactDivisor, junk);
             }
-            if (decimalNumber.length() != 1)
+            if (exactDivisor.length_ == 1)
             {
-                //all numbers must start from non-zero digit
-                valid &= (decimalNumber.GetDigit(0) != 0);
+                SmallDivide(dividend, exactDivisor.coefficients_[0], result, junk);
+                return;
+            }
+            if (dividend.length_ < exactDivisor.length_)
+            {
+                result.MakeZero();
+                return;
             }
 
-            if (valid)
+            result.Detach();
+            const StorageType* pDivisor = exactDivisor.coefficients_;
+            StorageType* pDividend = dividend.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            UnsignedValueType inverse = InverseModuloBase(pDivisor[0]);
+            IntType divisorLength = exactDivisor.length_;
+            IntType quotientLength = dividend.length_ - exactDivisor.length_ + 1;
+            for (IntType i = 0; i < quotientLength; ++i)
             {
-                for (IntType i = 0; i < decimalNumber.length() / 2; ++i)
+                DigitType factor = pDividend[i] * inverse % Base;
+                pResult[i] = factor;
+                UnsignedValueType carry = 0;
+                for (IntType j = 0; i + j < quotientLength; ++j)
                 {
-                    //in inner format digits placed in reversed order
-                    std::swap(decimalNumber.GetDigit(i),
-                        decimalNumber.GetDigit(decimalNumber.length() - i - 1));
-                }
-                Convert(decimalNumber, number);
-            }
+                    if (j >= divisorLength && carry == 0)
+                    {
+                        break;
+                    }
+                    UnsignedValueType temp = carry +
+                        (j < divisorLength ? factor * pDivisor[j] : 0);
+                    carry = temp / Base;
+                    DigitType digit = temp - carry * Base;
+                    if (pDividend[i + j] >= digit)
+                    {
+                        pDividend[i + j] -= digit;
+                    }
+                    else
+                    {
+                        pDividend[i + j] += Base - digit;
+                        ++carry;
+                    }
+                }
+            }
+            result.length_ = static_cast<SizeType>(quotientLength);
+            result.Trim();
+        }
+
+        // Function writes Base^(2 * length) / divisor into result, where length is
+        // the length of divisor, so that divisions by divisor reduce to multiplications.
+        // Long divisors are inverted by Newton iteration starting from the reciprocal
+        // of their top half, so inversion costs a few multiplications
+        // Note that memory allocated for result must suffice for calculation
+        static void Reciprocal(const LongNumber<Traits, Base>& divisor,
+            LongNumber<Traits, Base>& result)
+        {
+            SizeType length = divisor.length_;
+            LongNumber<Traits, Base> power(0, 2 * length + 1);
+            ShiftLeft(LongNumber<Traits, Base>(1), 2 * length, power);
+            if (length <= 8 || !UsesTransform(length / 2, length / 2))
+            {
+                Divide(power, divisor, result);
+                return;
+            }
+
+            // Reciprocal of top digits approximates the reciprocal with relative error
+            // below Base^(1 - half), one Newton step squares the error
+            SizeType half = length / 2 + 2;
+            SizeType shift = length - half;
+            LongNumber<Traits, Base> top(0, half);
+            ShiftRight(divisor, shift, top);
+            LongNumber<Traits, Base> topReciprocal(0, half + 2);
+            Reciprocal(top, topReciprocal);
+            LongNumber<Traits, Base> estimate(0, length + 3);
+            ShiftLeft(topReciprocal, shift, estimate);
+
+            // x = x + x * (Base^(2 * length) - divisor * x) / Base^(2 * length)
+            LongNumber<Traits, Base> product(0, 2 * length + 4);
+            LongNumber<Traits, Base> error(0, 2 * length + 4);
+            LongNumber<Traits, Base> correction(0, 3 * length + 8);
+            LongNumber<Traits, Base> shifted(0, length + 4);
+            LongNumber<Traits, Base> value(0, length + 4);
+            Multiply(divisor, estimate, product);
+            bool below = Compare(product, power) <= 0;
+            if (below)
+            {
+                Subtract(power, product, error);
+            }
+            else
+            {
+                Subtract(product, power, error);
+            }
+            Multiply(estimate, error, correction);
+            ShiftRight(correction, 2 * length, shifted);
+            if (below)
+            {
+                Add(estimate, shifted, value);
+            }
+            else
+            {
+                Subtract(estimate, shifted, value);
+            }
+
+            // Value differs from the reciprocal by a few units
+            Multiply(divisor, value, product);
+            while (Compare(product, power) > 0)
+            {
+                Subtract(value, 1, value);
+                Subtract(product, divisor, product);
+            }
+            Subtract(power, product, error);
+            while (Compare(error, divisor) >= 0)
+            {
+                Add(value, 1, value);
+                Subtract(error, divisor, error);
+            }
+            result = value;
+        }
+
+        // Function writes quotient and remainder of division of number over divisor
+        // into result and surplus if they are given, reciprocal must be computed by
+        // Reciprocal(divisor, reciprocal). Number is split into parts of divisor length
+        // and quotient of every part is estimated by multiplication (Barrett's method).
+        // Note that memory allocated for result must suffice for calculation
+        static void DivideByReciprocal(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& divisor,
+            const LongNumber<Traits, Base>& reciprocal,
+            LongNumber<Traits, Base>* ptrResult,
+            LongNumber<Traits, Base>* ptrSurplus)
+        {
+            IntType length = divisor.length_;
+            if (length == 1 || number.length_ < divisor.length_)
+            {
+                DivideCore(number, divisor, ptrResult, ptrSurplus);
+                return;
+            }
+
+            LongNumber<Traits, Base> part(0, 2 * length);
+            LongNumber<Traits, Base> estimate(0, length + 1);
+            LongNumber<Traits, Base> product(0, 2 * length + 3);
+            LongNumber<Traits, Base> quotient(0, length + 2);
+            LongNumber<Traits, Base> surplus(0, 2 * length);
+            if (ptrResult)
+            {
+                ptrResult->Detach();
+            }
+            IntType numberLength = number.length_;
+            for (IntType start = (numberLength - 1) / length * length; start >= 0; start -= length)
+            {
+                // Part consists of previous surplus followed by next digits of number
+                IntType end = std::min(start + length, numberLength);
+                for (IntType i = start; i < end; ++i)
+                {
+                    part.coefficients_[i - start] = number.coefficients_[i];
+                }
+                for (IntType i = 0; i < surplus.length_; ++i)
+                {
+                    part.coefficients_[end - start + i] = surplus.coefficients_[i];
+                }
+                part.length_ = static_cast<SizeType>(end - start + surplus.length_);
+                part.Trim();
+
+                // Estimate is less than quotient of part by at most two
+                ShiftRight(part, length - 1, estimate);
+                Multiply(estimate, reciprocal, product);
+                ShiftRight(product, length + 1, quotient);
+                Multiply(quotient, divisor, product);
+                Subtract(part, product, surplus);
+                while (Compare(surplus, divisor) >= 0)
+                {
+                    Subtract(surplus, divisor, surplus);
+                    Add(quotient, 1, quotient);
+                }
+
+                if (ptrResult)
+                {
+                    for (IntType i = 0; i < end - start; ++i)
+                    {
+                        ptrResult->coefficients_[start + i] =
+                            i < quotient.length_ ? quotient.coefficients_[i] : 0;
+                    }
+                }
+            }
+            if (ptrResult)
+            {
+                ptrResult->length_ = number.length_;
+                ptrResult->Trim();
+            }
+            if (ptrSurplus)
+            {
+                *ptrSurplus = surplus;
+            }
+        }
+
+    private:
+        // Function writes number with halves of digits given by pointwise product
+        // of transforms into result or adds it to result if accumulate is set,
+        // length is the upper bound of its length
+        static void FromTransform(TransformType& values,
+            SizeType length,
+            bool accumulate,
+            LongNumber<Traits, Base>& result)
+        {
+            constexpr DigitType halfBase = HalfBase();
+            LongTransform<Traits>::Inverse(values, 1);
+            result.Detach();
+            IntType resultLength = length;
+            if (accumulate)
+            {
+                resultLength = std::max<IntType>(result.length_, length) + 1;
+            }
+            UnsignedValueType carry = 0;
+            for (IntType i = 0; i < resultLength; ++i)
+            {
+                DigitType digit = accumulate && i < result.length_ ? result.coefficients_[i] : 0;
+                if (i < length)
+                {
+                    carry += values[2 * i];
+                }
+                carry += digit % halfBase;
+                DigitType low = carry % halfBase;
+                carry = carry / halfBase + digit / halfBase;
+                if (i < length)
+                {
+                    carry += values[2 * i + 1];
+                }
+                DigitType high = carry % halfBase;
+                carry /= halfBase;
+                result.coefficients_[i] = high * halfBase + low;
+            }
+            result.length_ = static_cast<SizeType>(resultLength);
+            result.Trim();
+        }
+
+        // Function subtracts product given by transform values of the first length
+        // digits from result like SubMul
+        static bool SubtractTransform(TransformType& values,
+            SizeType length,
+            LongNumber<Traits, Base>& result)
+        {
+            constexpr ValueType halfBase = HalfBase();
+            LongTransform<Traits>::Inverse(values, 1);
+            result.Detach();
+            IntType resultLength = std::max<IntType>(result.length_, length);
+            // Values are below the modulus, so they and the carry fit into ValueType
+            ValueType carry = 0;
+            for (IntType i = 0; i < resultLength; ++i)
+            {
+                ValueType digit = i < result.length_ ? result.coefficients_[i] : 0;
+                carry += digit % halfBase;
+                if (i < length)
+                {
+                    carry -= ValueType(values[2 * i]);
+                }
+                ValueType low = (carry % halfBase + halfBase) % halfBase;
+                carry = (carry - low) / halfBase + digit / halfBase;
+                if (i < length)
+                {
+                    carry -= ValueType(values[2 * i + 1]);
+                }
+                ValueType high = (carry % halfBase + halfBase) % halfBase;
+                carry = (carry - high) / halfBase;
+                result.coefficients_[i] = static_cast<StorageType>(high * halfBase + low);
+            }
+            result.length_ = static_cast<SizeType>(resultLength);
+            if (carry < 0)
+            {
+                Complement(result);
+            }
+            result.Trim();
+            return carry < 0;
+        }
+
+        // Function replaces number by Base^length - number, where length
+        // is the length of nonzero number
+        static void Complement(LongNumber<Traits, Base>& number)
+        {
+            StorageType* pNumber = number.coefficients_;
+            IntType i = 0;
+            while (pNumber[i] == 0)
+            {
+                ++i;
+            }
+            pNumber[i] = static_cast<StorageType>(Base - pNumber[i]);
+            for (++i; i < number.length_; ++i)
+            {
+                pNumber[i] = static_cast<StorageType>(Base - 1 - pNumber[i]);
+            }
+        }
+
+        // Returns a divisor of number, which divides Base^2 and is small enough
+        // for SmallDivide, or 1 if number is coprime with Base. It is collected
+        // from the lowest two digits of number, which determine number modulo Base^2
+        static DigitType BaseFactor(const LongNumber<Traits, Base>& number)
+        {
+            const DigitType maxFactor = DigitType(std::numeric_limits<IntType>::max() / Base);
+            const UnsignedValueType square = UnsignedValueType(Base) * Base;
+            UnsignedValueType rest = number.coefficients_[0];
+            if (number.length_ > 1)
+            {
+                rest += UnsignedValueType(number.coefficients_[1]) * Base;
+            }
+            DigitType factor = 1;
+            while (true)
+            {
+                DigitType common = GreatestCommonDivisor(rest % Base, Base);
+                if (common == 1 || factor * common > maxFactor ||
+                    square % (factor * common) != 0)
+                {
+                    break;
+                }
+                factor *= common;
+                rest /= common;
+            }
+            return factor;
+        }
+
+        static DigitType GreatestCommonDivisor(DigitType lhs, DigitType rhs)
+        {
+            while (rhs != 0)
+            {
+                DigitType rest = lhs % rhs;
+                lhs = rhs;
+                rhs = rest;
+            }
+            return lhs;
+        }
+
+        // Returns inverse of digit coprime with Base modulo Base
+        static DigitType InverseModuloBase(DigitType digit)
+        {
+            IntType previous = 0, current = 1;
+            IntType previousRest = Base, currentRest = digit;
+            while (currentRest != 0)
+            {
+                IntType factor = previousRest / currentRest;
+                IntType next = previous - factor * current;
+                previous = current;
+                current = next;
+                next = previousRest - factor * currentRest;
+                previousRest = currentRest;
+                currentRest = next;
+            }
+            return previous < 0 ? previous + Base : previous;
+        }
+
+        // Long division, which writes quotient and remainder into result and surplus
+        // unless they are null
+        static void DivideCore(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& divisor,
+            LongNumber<Traits, Base>* ptrResult,
+            LongNumber<Traits, Base>* ptrSurplus)
+        {
+            if (number.length_ < divisor.length_)
+            {
+                if (ptrSurplus)
+                {
+                    *ptrSurplus = number;
+                }
+                if (ptrResult)
+                {
+                    ptrResult->MakeZero();
+                }
+                return;
+            }
+            if (divisor.length_ == 1)
+            {
+                DigitType digitSurplus;
+                if (ptrResult)
+                {
+                    SmallDivide(number, divisor.coefficients_[0], *ptrResult, digitSurplus);
+                }
+                else
+                {
+                    digitSurplus = SmallRemainder(number, divisor.coefficients_[0]);
+                }
+                if (ptrSurplus)
+                {
+                    ptrSurplus->Assign(digitSurplus);
+                }
+                return;
+            }
+
+            IntType i;
+            LongNumber<Traits, Base> numberCopy(0, number.length_ + 1);
+            for (i = 0; i < number.length_; ++i)
+                numberCopy.coefficients_[i] = number.coefficients_[i];
+            numberCopy.coefficients_[number.length_] = 0;
+            numberCopy.length_ = number.length_;
+
+            if (ptrResult)
+            {
+                ptrResult->Detach();
+            }
+            StorageType* pNumberCopy = numberCopy.coefficients_;
+            StorageType* pResult = ptrResult ? ptrResult->coefficients_ : 0;
+
+            IntType diffLength = number.length_ - divisor.length_;
+
+            IntType numberCopyCounter, resultShift;
+            StorageType* numberCopyShift;
+            IntType tempValue, storageValue, temp;
+            IntType factorGuess, helpValue;
+            IntType borrow, carry;
+
+            // Divisor is normalized in scratch memory, so it is never modified
+            // and can be shared by concurrent divisions
+            LongNumber<Traits, Base> scaledDivisor(0, divisor.length_ + 1);
+            const StorageType* pDivisor = divisor.coefficients_;
+            DigitType scale = Base / (divisor.coefficients_[divisor.length_ - 1] + 1);
+            if (scale > 1)
+            {
+                SmallMultiply(numberCopy, scale, numberCopy);
+                SmallMultiply(divisor, scale, scaledDivisor);
+                pDivisor = scaledDivisor.coefficients_;
+            }
+
+            for (resultShift = diffLength, numberCopyCounter = divisor.length_ + resultShift;
+                resultShift >= 0;
+                --resultShift, --numberCopyCounter)
+            {
+                factorGuess = (IntType(pNumberCopy[numberCopyCounter]) * Base +
+                    pNumberCopy[numberCopyCounter - 1]) / pDivisor[divisor.length_ - 1];
+                helpValue = (IntType(pNumberCopy[numberCopyCounter]) * Base +
+                    pNumberCopy[numberCopyCounter - 1]) % pDivisor[divisor.length_ - 1];
+                while (helpValue < Base)
+                {
+                    storageValue = pDivisor[divisor.length_ - 2] * factorGuess;
+                    tempValue = helpValue * Base + pNumberCopy[numberCopyCounter - 2];
+                    if ((storageValue > tempValue) || (factorGuess == Base))
+                    {
+                        --factorGuess;
+                        helpValue += pDivisor[divisor.length_ - 1];
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                carry = 0;
+                borrow = 0;
+                numberCopyShift = pNumberCopy + resultShift;
+                for (i = 0; i < divisor.length_; ++i)
+                {
+                    tempValue = pDivisor[i] * factorGuess + carry;
+                    carry = tempValue / Base;
+                    tempValue -= carry * Base;
+                    storageValue = numberCopyShift[i] - tempValue + borrow;
+                    if (storageValue < 0)
+                    {
+                        numberCopyShift[i] = storageValue + Base;
+                        borrow = -1;
+                    }
+                    else
+                    {
+                        numberCopyShift[i] = storageValue;
+                        borrow = 0;
+                    }
+                }
+                storageValue = numberCopyShift[i] - carry + borrow;
+                if (storageValue < 0)
+                {
+                    numberCopyShift[i] = storageValue + Base;
+                    borrow = -1;
+                }
+                else
+                {
+                    numberCopyShift[i] = storageValue;
+                    borrow = 0;
+                }
+                if (borrow == 0)
+                {
+                    if (pResult)
+                    {
+                        pResult[resultShift] = factorGuess;
+                    }
+                }
+                else
+                {
+                    if (pResult)
+                    {
+                        pResult[resultShift] = factorGuess - 1;
+                    }
+                    carry = 0;
+                    for (i = 0; i < divisor.length_; ++i)
+                    {
+                        temp = carry + numberCopyShift[i] + pDivisor[i];
+                        if (temp >= Base)
+                        {
+                            numberCopyShift[i] = temp - Base;
+                            carry = 1;
+                        }
+                        else
+                        {
+                            numberCopyShift[i] = temp;
+                            carry = 0;
+                        }
+                    }
+                    numberCopyShift[i] = numberCopyShift[i] + carry - Base;
+                }
+                i = numberCopy.length_ - 1;
+                while (i > 0 && pNumberCopy[i] == 0)
+                {
+                    --i;
+                }
+                numberCopy.length_ = static_cast<SizeType>(i + 1);
+            }
+            if (ptrResult)
+            {
+                while (diffLength > 0 && pResult[diffLength] == 0)
+                {
+                    diffLength--;
+                }
+                ptrResult->length_ = static_cast<SizeType>(diffLength + 1);
+            }
+            if (scale > 1)
+            {
+                if (ptrSurplus)
+                {
+                    DigitType junk = 0;
+                    ptrSurplus->Reserve(numberCopy.length_);
+                    SmallDivide(numberCopy, scale, *ptrSurplus, junk);
+                }
+            }
+            else if (ptrSurplus)
+            {
+                *ptrSurplus = numberCopy;
+            }
+        }
+
+    public:
+        // Function writes product of number and numeral into result
+        // Note that memory allocated for result must suffice for calculation
+        static void SmallMultiply(const LongNumber<Traits, Base>& number,
+            const DigitType numeral,
+            LongNumber<Traits, Base>& result)
+        {
+            result.Detach();
+            IntType i;
+            IntType temp, carry = 0;
+            const StorageType* pNumber = number.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            for (i = 0; i < number.length_; ++i)
+            {
+                temp = pNumber[i] * numeral + carry;
+                carry = temp / Base;
+                pResult[i] = temp - carry * Base;
+            }
+            if (carry)
+            {
+                pResult[i] = carry;
+                result.length_ = number.length_ + 1;
+            }
+            else
+                result.length_ = number.length_;
+        }
+
+        // Function writes result of division of number over numeral into result
+        // Note that memory allocated for result must suffice for calculation
+        static void SmallDivide(const LongNumber<Traits, Base>& number,
+            const DigitType numeral,
+            LongNumber<Traits, Base>& result,
+            DigitType& surplus)
+        {
+            result.Detach();
+            IntType r = 0, temp;
+            const StorageType* pNumber = number.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            IntType i;
+            for (i = number.length_ - 1; i >= 0; --i)
+            {
+                temp = r * Base + pNumber[i];
+                pResult[i] = temp / numeral;
+                r = temp - pResult[i] * numeral;
+            }
+            surplus = r;
+            i = number.length_ - 1;
+            while (i > 0 && pResult[i] == 0)
+            {
+                --i;
+            }
+            result.length_ = static_cast<SizeType>(i + 1);
+        }
+
+        // Maximal number of digits of UnsignedValueType integer
+        static constexpr SizeType NativeLength()
+        {
+            SizeType length = 1;
+            for (UnsignedValueType rest = std::numeric_limits<UnsignedValueType>::max() / Base;
+                rest > 0;
+                rest /= Base)
+            {
+                ++length;
+            }
+            return length;
+        }
+
+        static int Compare(const LongNumber<Traits, Base>& number,
+            UnsignedValueType integer)
+        {
+            StorageType digits[NativeLength()];
+            SizeType length = SplitNative(integer, digits);
+            if (number.length_ != length)
+            {
+                return number.length_ > length ? 1 : -1;
+            }
+            for (IntType i = length - 1; i >= 0; --i)
+            {
+                if (number.coefficients_[i] != digits[i])
+                {
+                    return number.coefficients_[i] > digits[i] ? 1 : -1;
+                }
+            }
+            return 0;
+        }
+
+        // Returns sign of difference of number and product of multiplier and integer
+        static int CompareProduct(const LongNumber<Traits, Base>& number,
+            const LongNumber<Traits, Base>& multiplier,
+            UnsignedValueType integer)
+        {
+            StorageType digits[NativeLength()];
+            SizeType length = SplitNative(integer, digits);
+            IntType productLength = IntType(multiplier.length_) + length;
+            // Product without leading zeros has at least productLength - 1 digits
+            if (number.length_ > productLength)
+            {
+                return 1;
+            }
+            if (number.length_ < productLength - 1)
+            {
+                return -1;
+            }
+            // Digits are compared from the lowest one, the highest difference decides
+            int comparison = 0;
+            UnsignedValueType carry = 0;
+            for (IntType i = 0; i < productLength; ++i)
+            {
+                DigitType digit = ProductDigit(multiplier, digits, length, i, carry);
+                DigitType numberDigit = i < number.length_ ? number.coefficients_[i] : 0;
+                if (numberDigit != digit)
+                {
+                    comparison = numberDigit > digit ? 1 : -1;
+                }
+            }
+            return comparison;
+        }
+
+        // Function adds product of number and integer to result
+        // Note that
+        // Memory allocated for result must suffice for calculation
+        // Result must not be number
+        static void AddMul(const LongNumber<Traits, Base>& number,
+            UnsignedValueType integer,
+            LongNumber<Traits, Base>& result)
+        {
+            result.Detach();
+            StorageType digits[NativeLength()];
+            SizeType length = SplitNative(integer, digits);
+            IntType productLength = IntType(number.length_) + length;
+            IntType total = std::max<IntType>(result.length_, productLength) + 1;
+            StorageType* pResult = result.coefficients_;
+            for (IntType i = result.length_; i < total; ++i)
+            {
+                pResult[i] = 0;
+            }
+            UnsignedValueType carry = 0;
+            DigitType sum = 0;
+            for (IntType i = 0; i < total && (i < productLength || sum > 0); ++i)
+            {
+                if (i < productLength)
+                {
+                    sum += ProductDigit(number, digits, length, i, carry);
+                }
+                sum += pResult[i];
+                pResult[i] = static_cast<StorageType>(sum % Base);
+                sum /= Base;
+            }
+            result.length_ = static_cast<SizeType>(total);
+            result.Trim();
+        }
+
+        // Function subtracts product of number and integer from result
+        // and returns true if the product exceeds result, in which case
+        // result holds the absolute value of the difference
+        // Note that
+        // Memory allocated for result must suffice for calculation
+        // Result must not be number
+        static bool SubMul(const LongNumber<Traits, Base>& number,
+            UnsignedValueType integer,
+            LongNumber<Traits, Base>& result)
+        {
+            result.Detach();
+            StorageType digits[NativeLength()];
+            SizeType length = SplitNative(integer, digits);
+            IntType productLength = IntType(number.length_) + length;
+            IntType total = std::max<IntType>(result.length_, productLength);
+            StorageType* pResult = result.coefficients_;
+            for (IntType i = result.length_; i < total; ++i)
+            {
+                pResult[i] = 0;
+            }
+            UnsignedValueType carry = 0;
+            DigitType borrow = 0;
+            for (IntType i = 0; i < total && (i < productLength || borrow > 0); ++i)
+            {
+                if (i < productLength)
+                {
+                    borrow += ProductDigit(number, digits, length, i, carry);
+                }
+                if (pResult[i] >= borrow)
+                {
+                    pResult[i] = static_cast<StorageType>(pResult[i] - borrow);
+                    borrow = 0;
+                }
+                else
+                {
+                    pResult[i] = static_cast<StorageType>(pResult[i] + Base - borrow);
+                    borrow = 1;
+                }
+            }
+            result.length_ = static_cast<SizeType>(total);
+            // Borrow out of the top digit means that result holds
+            // Base^total plus the negative difference
+            bool negative = borrow > 0;
+            if (negative)
+            {
+                Complement(result);
+            }
+            result.Trim();
+            return negative;
+        }
+
+        // Function writes sum of number and integer into result
+        // Note that memory allocated for result must suffice for calculation
+        static void Add(const LongNumber<Traits, Base>& number,
+            UnsignedValueType integer,
+            LongNumber<Traits, Base>& result)
+        {
+            result.Detach();
+            const StorageType* pNumber = number.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            UnsignedValueType carry = integer;
+            IntType i;
+            for (i = 0; i < number.length_; ++i)
+            {
+                if (carry == 0 && pNumber == pResult)
+                {
+                    // The rest of digits is already in place
+                    i = number.length_;
+                    break;
+                }
+                UnsignedValueType temp = pNumber[i] + carry % Base;
+                carry /= Base;
+                if (temp >= Base)
+                {
+                    temp -= Base;
+                    ++carry;
+                }
+                pResult[i] = temp;
+            }
+            for (; carry > 0; ++i)
+            {
+                pResult[i] = carry % Base;
+                carry /= Base;
+            }
+            result.length_ = static_cast<SizeType>(i);
+        }
+
+        // Function writes result of subtraction integer from number into result
+        // Note that number must not be less than integer
+        static void Subtract(const LongNumber<Traits, Base>& number,
+            UnsignedValueType integer,
+            LongNumber<Traits, Base>& result)
+        {
+            result.Detach();
+            const StorageType* pNumber = number.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            UnsignedValueType borrow = integer;
+            for (IntType i = 0; i < number.length_; ++i)
+            {
+                if (borrow == 0)
+                {
+                    if (pNumber == pResult)
+                    {
+                        break;
+                    }
+                    pResult[i] = pNumber[i];
+                    continue;
+                }
+                DigitType digit = borrow % Base;
+                borrow /= Base;
+                if (pNumber[i] >= digit)
+                {
+                    pResult[i] = pNumber[i] - digit;
+                }
+                else
+                {
+                    pResult[i] = pNumber[i] + Base - digit;
+                    ++borrow;
+                }
+            }
+            result.length_ = number.length_;
+            result.Trim();
+        }
+
+        // Function writes product of number and integer into result
+        // Note that memory allocated for result must suffice for calculation
+        // Call Multiply(A,b,A) works
+        static void Multiply(const LongNumber<Traits, Base>& number,
+            UnsignedValueType integer,
+            LongNumber<Traits, Base>& result)
+        {
+            if (integer < Base)
+            {
+                SmallMultiply(number, integer, result);
+                result.Trim();
+                return;
+            }
+            result.Detach();
+            StorageType digits[NativeLength()];
+            SizeType length = SplitNative(integer, digits);
+            // Last digits of number are kept in window, so result may overwrite number
+            DigitType window[NativeLength()] = {};
+            const StorageType* pNumber = number.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            UnsignedValueType carry = 0;
+            IntType i;
+            for (i = 0; i < number.length_ + length - 1 || carry > 0; ++i)
+            {
+                for (IntType j = length - 1; j > 0; --j)
+                {
+                    window[j] = window[j - 1];
+                }
+                window[0] = i < number.length_ ? pNumber[i] : 0;
+                UnsignedValueType temp = carry;
+                for (SizeType j = 0; j < length; ++j)
+                {
+                    temp += window[j] * digits[j];
+                }
+                carry = temp / Base;
+                pResult[i] = temp - carry * Base;
+            }
+            result.length_ = static_cast<SizeType>(i);
+            result.Trim();
+        }
+
+        // Function writes result of division of number over integer into result
+        // and remainder into surplus
+        // Note that memory allocated for result must suffice for calculation
+        static void Divide(const LongNumber<Traits, Base>& number,
+            UnsignedValueType integer,
+            LongNumber<Traits, Base>& result,
+            UnsignedValueType& surplus)
+        {
+            if (integer <= UnsignedValueType(std::numeric_limits<IntType>::max() / Base))
+            {
+                DigitType digitSurplus;
+                SmallDivide(number, integer, result, digitSurplus);
+                surplus = digitSurplus;
+                return;
+            }
+            result.Detach();
+            const StorageType* pNumber = number.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            WideValueType r = 0;
+            for (IntType i = number.length_ - 1; i >= 0; --i)
+            {
+                r = r * Base + pNumber[i];
+                pResult[i] = static_cast<DigitType>(r / integer);
+                r %= integer;
+            }
+            surplus = static_cast<UnsignedValueType>(r);
+            result.length_ = number.length_;
+            result.Trim();
+        }
+
+        // Returns remainder of division of number over integer
+        // without computation of quotient
+        static UnsignedValueType Remainder(const LongNumber<Traits, Base>& number,
+            UnsignedValueType integer)
+        {
+            if (integer <= UnsignedValueType(std::numeric_limits<IntType>::max() / Base))
+            {
+                return SmallRemainder(number, integer);
+            }
+            const StorageType* pNumber = number.coefficients_;
+            WideValueType r = 0;
+            for (IntType i = number.length_ - 1; i >= 0; --i)
+            {
+                r = (r * Base + pNumber[i]) % integer;
+            }
+            return static_cast<UnsignedValueType>(r);
+        }
+
+        // Returns value of number which must fit into UnsignedValueType
+        static UnsignedValueType ToNative(const LongNumber<Traits, Base>& number)
+        {
+            UnsignedValueType integer = 0;
+            for (IntType i = number.length_ - 1; i >= 0; --i)
+            {
+                integer = integer * Base + number.coefficients_[i];
+            }
+            return integer;
+        }
+
+        // Writes digits of integer into existing data of number
+        void Assign(UnsignedValueType integer)
+        {
+            Reserve(NativeLength());
+            Detach();
+            length_ = SplitNative(integer, coefficients_);
+        }
+
+        // Returns remainder of division of number over numeral
+        // Note that numeral * Base must fit into IntType
+        static DigitType SmallRemainder(const LongNumber<Traits, Base>& number,
+            const DigitType numeral)
+        {
+            IntType r = 0;
+            const StorageType* pNumber = number.coefficients_;
+            for (IntType i = number.length_ - 1; i >= 0; --i)
+            {
+                r = (r * Base + pNumber[i]) % numeral;
+            }
+            return r;
+        }
+
+        // Function writes number multiplied by Base^shift into result
+        // Note that memory allocated for result must suffice for calculation
+        static void ShiftLeft(const LongNumber<Traits, Base>& number,
+            const SizeType shift,
+            LongNumber<Traits, Base>& result)
+        {
+            result.Detach();
+            const StorageType* pNumber = number.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            if (number.length_ == 1 && pNumber[0] == 0)
+            {
+                pResult[0] = 0;
+                result.length_ = 1;
+                return;
+            }
+            SizeType length = number.length_;
+            for (IntType i = length - 1; i >= 0; --i)
+            {
+                pResult[i + shift] = pNumber[i];
+            }
+            for (IntType i = 0; i < shift; ++i)
+            {
+                pResult[i] = 0;
+            }
+            result.length_ = length + shift;
+        }
+
+        // Function writes number divided by Base^shift into result
+        // Note that memory allocated for result must suffice for calculation
+        static void ShiftRight(const LongNumber<Traits, Base>& number,
+            const SizeType shift,
+            LongNumber<Traits, Base>& result)
+        {
+            result.Detach();
+            const StorageType* pNumber = number.coefficients_;
+            StorageType* pResult = result.coefficients_;
+            if (number.length_ <= shift)
+            {
+                pResult[0] = 0;
+                result.length_ = 1;
+                return;
+            }
+            for (IntType i = shift; i < number.length_; ++i)
+            {
+                pResult[i - shift] = pNumber[i];
+            }
+            result.length_ = number.length_ - shift;
+        }
+
+        // Reads number from stream istr, validate it and converts to inner format
+        friend std::istream& operator >> (std::istream& istr,
+            LongNumber<Traits, Base>& number)
+        {
+            std::string numberString;
+            istr >> numberString;
+
+            bool valid = !numberString.empty() &&
+                IsDecimal(numberString.data(), numberString.data() + numberString.size());
+            if (numberString.size() > 1)
+            {
+                //all numbers must start from non-zero digit
+                valid &= (numberString[0] != '0');
+            }
+
+            if (valid)
+            {
+                ParseDecimal(numberString.data(),
+                    numberString.data() + numberString.size(), number);
+            }
+            else
+            {
+                istr.setstate(std::ios::failbit);
+            }
             return istr;
         }
 
@@ -533,6 +1645,19 @@ namespace LongArithmetic
         friend std::ostream& operator << (std::ostream& ostr,
             const LongNumber<Traits, Base>& number)
         {
+            SizeType decimalLength = DecimalLength();
+            if (decimalLength > 0)
+            {
+                // Every digit is written as a block of decimal digits
+                ostr << number.coefficients_[number.length_ - 1];
+                char fill = ostr.fill('0');
+                for (IntType i = IntType(number.length_) - 2; i >= 0; --i)
+                {
+                    ostr << std::setw(decimalLength) << number.coefficients_[i];
+                }
+                ostr.fill(fill);
+                return ostr;
+            }
             LongNumber<Traits, DECIMAL_BASE> decimalNumber;
             Convert(number, decimalNumber);
             for (IntType i = decimalNumber.Length() - 1; i >= 0; --i)
@@ -542,6 +1667,101 @@ namespace LongArithmetic
             return ostr;
         }
 
+        // Tells whether all characters in [first, last) are decimal digits.
+        // Blocks of eight characters are checked at once: both adding 6 and
+        // taking high halves of bytes keep 3 only for characters '0'..'9'
+        static bool IsDecimal(const char* first, const char* last)
+        {
+            const std::uint64_t highHalves = 0xF0F0F0F0F0F0F0F0ULL;
+            for (; last - first >= 8; first += 8)
+            {
+                std::uint64_t block;
+                std::memcpy(&block, first, sizeof(block));
+                if (((block & highHalves) | (((block + 0x0606060606060606ULL) & highHalves) >> 4)) !=
+                    0x3333333333333333ULL)
+                {
+                    return false;
+                }
+            }
+            for (; first != last; ++first)
+            {
+                if (*first < '0' || '9' < *first)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Writes number given by decimal digits in [first, last) into number.
+        // Leading zeros are allowed, characters must be validated by caller.
+        static void ParseDecimal(const char* first, const char* last,
+            LongNumber<Traits, Base>& number)
+        {
+            SizeType decimalLength = DecimalLength();
+            if (decimalLength == 0)
+            {
+                LongNumber<Traits, DECIMAL_BASE> decimalNumber(0,
+                    static_cast<SizeType>(last - first));
+                for (IntType i = 0; i < last - first; ++i)
+                {
+                    //in inner format digits placed in reversed order
+                    decimalNumber.GetDigit(i) = last[-1 - i] - '0';
+                }
+                decimalNumber.Length() = static_cast<SizeType>(last - first);
+                decimalNumber.Trim();
+                Convert(decimalNumber, number);
+                return;
+            }
+
+            // Every block of decimalLength decimal digits forms a digit
+            SizeType length = static_cast<SizeType>(
+                (last - first + decimalLength - 1) / decimalLength);
+            if (length == 0)
+            {
+                length = 1;
+            }
+            if (number.size_ < length)
+            {
+                number.Deallocate();
+                number.Allocate(length);
+            }
+            number.Detach();
+            for (SizeType i = 0; i < length; ++i)
+            {
+                const char* blockEnd = last - IntType(i) * decimalLength;
+                const char* blockBegin = blockEnd - first > IntType(decimalLength) ?
+                    blockEnd - decimalLength :
+                    first;
+                DigitType digit = 0;
+                for (const char* symbol = blockBegin; symbol < blockEnd; ++symbol)
+                {
+                    digit = digit * DECIMAL_BASE + (*symbol - '0');
+                }
+                number.coefficients_[i] = digit;
+            }
+            if (first == last)
+            {
+                number.coefficients_[0] = 0;
+            }
+            number.length_ = length;
+            number.Trim();
+        }
+
+        // Returns number of decimal digits in one digit if Base is a power of ten
+        // and zero otherwise
+        static constexpr SizeType DecimalLength()
+        {
+            SizeType length = 0;
+            UnsignedValueType power = 1;
+            while (power < Base)
+            {
+                power *= DECIMAL_BASE;
+                ++length;
+            }
+            return power == Base ? length : 0;
+        }
+
         // Returns a BaseNumber with digits in newBase scale of notation
         template <BaseType oldBase, BaseType newBase>
         static void Convert(const LongNumber<Traits, oldBase> oldNumber,
@@ -569,14 +1789,18 @@ namespace LongArithmetic
             LongNumber<Traits, oldBase> quotient(0, number.length_);
             LongNumber<Traits, oldBase> surplus(0, newBaseCopy.length_);
 
+            LongNumber<Traits, oldBase> reciprocal(0, newBaseCopy.length_ + 2);
+            LongNumber<Traits, oldBase>::Reciprocal(newBaseCopy, reciprocal);
+
             LongNumber<Traits, oldBase>* pDividend = &number;
             LongNumber<Traits, oldBase>* pQuotient = &quotient;
 
             do
             {
-                Divide(*pDividend, newBaseCopy, *pQuotient, surplus);
+                LongNumber<Traits, oldBase>::DivideByReciprocal(*pDividend, newBaseCopy,
+                    reciprocal, pQuotient, &surplus);
                 newNumber.GetDigit(newNumber.Length()) = 0;
-                for (IntType k = 0, power = 1; k < surplus.length_; ++k, power *= Base)
+                for (IntType k = 0, power = 1; k < surplus.length_; ++k, power *= oldBase)
                 {
                     newNumber.GetDigit(newNumber.Length()) +=
                         surplus.coefficients_[k] * power;
@@ -647,9 +1871,19 @@ namespace LongArithmetic
                 throw std::out_of_range("Parameter out of range");
         }
 
+        // Removes leading zero digits
+        void Trim()
+        {
+            while (length_ > 1 && coefficients_[length_ - 1] == 0)
+            {
+                --length_;
+            }
+        }
+
         // Sets all allocated digits to zero
         void MakeZero()
         {
+            Detach();
             for (IntType i = 0; i < size_; ++i)
             {
                 coefficients_[i] ^= coefficients_[i];
@@ -660,26 +1894,20 @@ namespace LongArithmetic
         // Allocates new data and set new value for size_, without freeing old data
         void Allocate(SizeType newSize)
         {
-            coefficients_ = new DigitType[newSize];
-            if (coefficients_ == 0)
-            {
-                throw std::runtime_error("Can\'t allocate memory");
-            }
+            coefficients_ = AllocateStorage(newSize);
             size_ = newSize;
         }
 
         // Changes size of coefficients_ array
         void Resize(SizeType newSize)
         {
-            DigitType* storage = new DigitType[newSize];
-            if (storage == 0)
-                throw std::runtime_error("Can\'t reallocate memory");
+            StorageType* storage = AllocateStorage(newSize);
             SizeType rest = std::min(length_, newSize);
             if (coefficients_ != 0)
             {
                 for (IntType i = 0; i < rest; ++i)
                     storage[i] = coefficients_[i];
-                delete[] coefficients_;
+                ReleaseStorage(coefficients_);
             }
             coefficients_ = storage;
             size_ = newSize;
@@ -690,25 +1918,38 @@ namespace LongArithmetic
         {
             if (newSize > size_)
             {
-                DigitType* storage = new DigitType[newSize];
-                if (storage == 0)
-                    throw std::runtime_error("Can\'t reallocate memory");
-                if (coefficients_ != 0)
-                {
-                    for (IntType i = 0; i < length_; ++i)
-                        storage[i] = coefficients_[i];
-                    delete[] coefficients_;
-                }
+                Resize(newSize);
+            }
+        }
+
+        // Makes digits not shared with other numbers before they are modified
+        void Detach()
+        {
+            if (CopyOnWrite && coefficients_ != 0 &&
+                Header(coefficients_)->references.load(std::memory_order_acquire) > 1)
+            {
+                StorageType* storage = AllocateStorage(size_);
+                for (IntType i = 0; i < length_; ++i)
+                    storage[i] = coefficients_[i];
+                ReleaseStorage(coefficients_);
                 coefficients_ = storage;
-                size_ = newSize;
             }
         }
 
+        // Exchanges data with other number without copying digits
+        void Swap(LongNumber<Traits, Base>& other)
+        {
+            std::swap(coefficients_, other.coefficients_);
+            std::swap(length_, other.length_);
+            std::swap(size_, other.size_);
+        }
+
         // Destroys data with check for null pointer and set size_ to zero
         void Deallocate()
         {
             if (coefficients_ != 0)
-                delete[] coefficients_;
+                ReleaseStorage(coefficients_);
+            coefficients_ = 0;
             size_ = 0;
         }
 
@@ -720,10 +1961,101 @@ namespace LongArithmetic
         }
 
     private:
-        DigitType *coefficients_;
+        // Writes digits of integer into digits and returns their number
+        static SizeType SplitNative(UnsignedValueType integer, StorageType* digits)
+        {
+            SizeType length = 0;
+            do
+            {
+                digits[length++] = integer % Base;
+                integer /= Base;
+            } while (integer > 0);
+            return length;
+        }
+
+        // Returns digit i of product of number and integer split into length digits,
+        // carry holds the higher part of product of the lower digits
+        static DigitType ProductDigit(const LongNumber<Traits, Base>& number,
+            const StorageType* digits,
+            SizeType length,
+            IntType i,
+            UnsignedValueType& carry)
+        {
+            UnsignedValueType temp = carry;
+            for (IntType j = std::max<IntType>(0, i - number.length_ + 1);
+                j < length && j <= i;
+                ++j)
+            {
+                temp += UnsignedValueType(number.coefficients_[i - j]) * digits[j];
+            }
+            carry = temp / Base;
+            return static_cast<DigitType>(temp - carry * Base);
+        }
+
+        template <typename OtherTraits, typename OtherTraits::BaseType OtherBase>
+        friend class LongNumber;
+
+        // Shared digits are preceded by a counter of numbers sharing them,
+        // digits which are never shared have no counter
+        struct alignas(DigitType) StorageHeader
+        {
+            std::atomic<SizeType> references;
+        };
+
+        static const std::size_t HeaderSize = CopyOnWrite ? sizeof(StorageHeader) : 0;
+
+        static StorageHeader* Header(StorageType* coefficients)
+        {
+            return reinterpret_cast<StorageHeader*>(coefficients) - 1;
+        }
+
+        static StorageType* AllocateStorage(SizeType size)
+        {
+            void* memory = ::operator new(HeaderSize + size * sizeof(StorageType));
+            if (!CopyOnWrite)
+            {
+                return static_cast<StorageType*>(memory);
+            }
+            StorageHeader* header = new (memory) StorageHeader;
+            header->references.store(1, std::memory_order_relaxed);
+            return reinterpret_cast<StorageType*>(header + 1);
+        }
+
+        static void ReleaseStorage(StorageType* coefficients)
+        {
+            if (coefficients == 0)
+            {
+                return;
+            }
+            if (!CopyOnWrite)
+            {
+                ::operator delete(coefficients);
+                return;
+            }
+            StorageHeader* header = Header(coefficients);
+            if (header->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                header->~StorageHeader();
+                ::operator delete(header);
+            }
+        }
+
+        // Shares digits of number, which must not be owned by this.
+        // Number left by move has no digits, so nothing is shared then
+        void Share(const LongNumber<Traits, Base>& number)
+        {
+            coefficients_ = number.coefficients_;
+            size_ = number.size_;
+            if (coefficients_ != 0)
+            {
+                Header(coefficients_)->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        StorageType* coefficients_;
         SizeType length_;
         SizeType size_;
-        BaseType base_;
     };
 };
 
@@ -0,0 +1,192 @@
+#ifndef LONG_ARITHMETIC_LONG_PARSER_H_
+#define LONG_ARITHMETIC_LONG_PARSER_H_
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "long_rational.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+
+namespace LongArithmetic
+{
+    // Parsing of numbers directly from memory buffers and mapped files.
+    // Digits are validated eight at a time and packed into digits of the result
+    // without intermediate strings, so peak memory is close to the size of the result,
+    // while pages of mapped files are read by the system as they are parsed.
+    // Lists of numbers are parsed in parallel
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongParser
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using RationalType = LongRational<Traits, Base>;
+
+        // Function writes integer in format [-]digits surrounded by whitespace
+        // in [first, last) into result
+        static void Parse(const char* first, const char* last, IntegerType& result)
+        {
+            Trim(first, last);
+            if (!IntegerType::ParseDecimal(first, last, result))
+            {
+                throw std::invalid_argument("Malformed integer");
+            }
+        }
+
+        // Function writes rational in format [-]digits[/digits] surrounded by whitespace
+        // in [first, last) into result
+        static void Parse(const char* first, const char* last, RationalType& result)
+        {
+            Trim(first, last);
+            const char* slash = std::find(first, last, '/');
+            IntegerType numerator, denominator(1);
+            if (!IntegerType::ParseDecimal(first, slash, numerator) ||
+                (slash != last && !IntegerType::ParseDecimal(slash + 1, last, denominator)))
+            {
+                throw std::invalid_argument("Malformed rational");
+            }
+            result = RationalType(numerator, denominator);
+        }
+
+        // Function writes number which is the only content of file into result
+        template <typename NumberType>
+        static void ParseFile(const std::string& path, NumberType& result)
+        {
+            MappedFile file(path);
+            Parse(file.Data(), file.Data() + file.Size(), result);
+        }
+
+        // Function writes numbers separated by commas, whitespace and line breaks
+        // in [first, last) into numbers. Text is split on line boundaries between
+        // threads of pool, which count numbers of their lines first, so that every
+        // number is parsed in place in preallocated vector. Malformed numbers
+        // are reported by their line numbers
+        template <typename NumberType>
+        static void ParseList(const char* first, const char* last,
+            std::vector<NumberType>& numbers,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            std::size_t size = static_cast<std::size_t>(last - first);
+            std::size_t chunks = std::min<std::size_t>(4 * (pool.Size() + 1),
+                size / MinChunkSize + 1);
+            std::vector<const char*> bounds(chunks + 1, last);
+            bounds[0] = first;
+            for (std::size_t i = 1; i < chunks; ++i)
+            {
+                const char* bound = std::max(bounds[i - 1], first + size / chunks * i);
+                bound = std::find(bound, last, '\n');
+                bounds[i] = bound == last ? last : bound + 1;
+            }
+
+            std::vector<std::size_t> counts(chunks + 1, 0), lines(chunks + 1, 0);
+            pool.ParallelFor(chunks, [&](std::size_t i)
+            {
+                ForEachToken(bounds[i], bounds[i + 1], [&](const char*, const char*, std::size_t)
+                {
+                    ++counts[i + 1];
+                    return true;
+                });
+                lines[i + 1] = static_cast<std::size_t>(std::count(bounds[i], bounds[i + 1], '\n'));
+            });
+            for (std::size_t i = 0; i < chunks; ++i)
+            {
+                counts[i + 1] += counts[i];
+                lines[i + 1] += lines[i];
+            }
+
+            numbers.clear();
+            numbers.resize(counts[chunks]);
+            std::vector<std::size_t> errors(chunks, 0);
+            pool.ParallelFor(chunks, [&](std::size_t i)
+            {
+                std::size_t index = counts[i];
+                ForEachToken(bounds[i], bounds[i + 1],
+                    [&](const char* tokenFirst, const char* tokenLast, std::size_t line)
+                {
+                    try
+                    {
+                        Parse(tokenFirst, tokenLast, numbers[index++]);
+                    }
+                    catch (const std::logic_error&)
+                    {
+                        errors[i] = lines[i] + line + 1;
+                        return false;
+                    }
+                    return true;
+                });
+            });
+            for (std::size_t error : errors)
+            {
+                if (error != 0)
+                {
+                    throw std::invalid_argument("Malformed number at line " + std::to_string(error));
+                }
+            }
+        }
+
+        // Function writes numbers of file into numbers
+        template <typename NumberType>
+        static void ParseListFile(const std::string& path, std::vector<NumberType>& numbers,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            MappedFile file(path);
+            ParseList(file.Data(), file.Data() + file.Size(), numbers, pool);
+        }
+
+    private:
+        // Texts shorter than this are not split between threads
+        static const std::size_t MinChunkSize = 1 << 16;
+
+        // Separators are commas and whitespace of the C locale
+        static bool IsSeparator(char symbol)
+        {
+            return symbol == ',' || symbol == ' ' || ('\t' <= symbol && symbol <= '\r');
+        }
+
+        // Calls visit(tokenFirst, tokenLast, line) for every token between separators
+        // in [first, last), where line counts line breaks before token, until visit
+        // returns false
+        template <typename Visitor>
+        static void ForEachToken(const char* first, const char* last, const Visitor& visit)
+        {
+            std::size_t line = 0;
+            while (first != last)
+            {
+                if (IsSeparator(*first))
+                {
+                    line += *first == '\n' ? 1 : 0;
+                    ++first;
+                    continue;
+                }
+                const char* tokenLast = first;
+                while (tokenLast != last && !IsSeparator(*tokenLast))
+                {
+                    ++tokenLast;
+                }
+                if (!visit(first, tokenLast, line))
+                {
+                    return;
+                }
+                first = tokenLast;
+            }
+        }
+
+        // Removes whitespace around [first, last)
+        static void Trim(const char*& first, const char*& last)
+        {
+            while (first != last && std::isspace(static_cast<unsigned char>(*first)))
+            {
+                ++first;
+            }
+            while (first != last && std::isspace(static_cast<unsigned char>(last[-1])))
+            {
+                --last;
+            }
+        }
+    };
+};
+
+#endif
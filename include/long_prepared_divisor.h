@@ -0,0 +1,47 @@
+#ifndef LONG_ARITHMETIC_LONG_PREPARED_DIVISOR_H_
+#define LONG_ARITHMETIC_LONG_PREPARED_DIVISOR_H_
+
+#include <stdexcept>
+
+#include "long_integer.h"
+
+namespace LongArithmetic
+{
+    // Divisor with precomputed reciprocal for repeated divisions by the same number.
+    // Prepared divisor is never modified, so it can be shared by concurrent divisions
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongPreparedDivisor
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using NumberType = LongNumber<Traits, Base>;
+
+        explicit LongPreparedDivisor(const IntegerType& divisor)
+            : divisor_(divisor)
+            , reciprocal_(0, divisor.value_.Length() + 2)
+        {
+            if (divisor.IsZero())
+            {
+                throw std::domain_error("Division by zero");
+            }
+            NumberType::Reciprocal(divisor_.value_, reciprocal_);
+        }
+
+        const IntegerType& Divisor() const
+        {
+            return divisor_;
+        }
+
+        // Base^(2 * length) / |divisor|, where length is the length of divisor
+        const NumberType& Reciprocal() const
+        {
+            return reciprocal_;
+        }
+
+    private:
+        IntegerType divisor_;
+        NumberType reciprocal_;
+    };
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef LONG_ARITHMETIC_LONG_PREPARED_MULTIPLIER_H_
+#define LONG_ARITHMETIC_LONG_PREPARED_MULTIPLIER_H_
+
+#include <map>
+#include <mutex>
+
+#include "long_integer.h"
+
+namespace LongArithmetic
+{
+    // Multiplier with cached transforms for repeated multiplications by the same number.
+    // Transform of every size is computed once, on the first multiplication which
+    // needs it, and is shared by concurrent multiplications
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongPreparedMultiplier
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using NumberType = LongNumber<Traits, Base>;
+        using SizeType = typename NumberType::SizeType;
+        using TransformType = typename NumberType::TransformType;
+
+        explicit LongPreparedMultiplier(const IntegerType& multiplier)
+            : multiplier_(multiplier)
+        {}
+
+        LongPreparedMultiplier(const LongPreparedMultiplier&) = delete;
+        LongPreparedMultiplier& operator = (const LongPreparedMultiplier&) = delete;
+
+        const IntegerType& Multiplier() const
+        {
+            return multiplier_;
+        }
+
+        // Transform of multiplier of given size
+        const TransformType& Transform(SizeType size) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            typename std::map<SizeType, TransformType>::iterator it = transforms_.find(size);
+            if (it == transforms_.end())
+            {
+                it = transforms_.emplace(size, TransformType()).first;
+                NumberType::Transform(multiplier_.value_, size, it->second);
+            }
+            return it->second;
+        }
+
+    private:
+        IntegerType multiplier_;
+        mutable std::mutex mutex_;
+        mutable std::map<SizeType, TransformType> transforms_;
+    };
+};
+
+#endif
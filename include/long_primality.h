@@ -0,0 +1,435 @@
+#ifndef LONG_ARITHMETIC_LONG_PRIMALITY_H_
+#define LONG_ARITHMETIC_LONG_PRIMALITY_H_
+
+#include <limits>
+#include <vector>
+
+#include "long_modular_context.h"
+#include "thread_pool.h"
+
+namespace LongArithmetic
+{
+    // Probable prime tests and search of primes.
+    // Numbers are divided by a table of small primes, which are grouped into products
+    // fitting one digit division, so every group costs one pass over digits.
+    // Numbers without small factors are checked by Baillie-PSW test, that is a strong
+    // probable prime test to base 2 followed by a strong Lucas test with parameters
+    // chosen by Selfridge's method, both computed in Montgomery arithmetic.
+    // No composite number passing Baillie-PSW test is known
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongPrimality
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using ContextType = LongModularContext<Traits, Base>;
+        using ResidueType = typename ContextType::ResidueType;
+        using DigitType = typename IntegerType::DigitType;
+        using ValueType = typename IntegerType::ValueType;
+        using IntType = typename IntegerType::IntType;
+
+        // Tells whether number is a probable prime, the answer is exact
+        // for numbers below 2^32
+        static bool IsProbablePrime(const IntegerType& number)
+        {
+            if (number.Sign() < 0 || number.Length() > 2)
+            {
+                return number.Sign() > 0 && SmallFactor(number, TrialLimit) == 0 &&
+                    IsBailliePSWPrime(number);
+            }
+            DigitType value = number.GetDigit(0) +
+                (number.Length() > 1 ? number.GetDigit(1) * DigitType(Base) : 0);
+            if (value < DigitType(1) << 32)
+            {
+                return IsSmallPrime(value);
+            }
+            return SmallFactor(number, TrialLimit) == 0 && IsBailliePSWPrime(number);
+        }
+
+        // Returns the least probable prime greater than number.
+        // Candidates in a window are sieved by the table of small primes
+        // and the rest of them are tested in parallel
+        static IntegerType NextPrime(const IntegerType& number,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            IntegerType candidate;
+            IntegerType::Add(number, IntegerType(1), candidate);
+            if (IntegerType::Compare(candidate, IntegerType(2)) <= 0)
+            {
+                return IntegerType(2);
+            }
+            if (candidate.GetDigit(0) % 2 == 0)
+            {
+                IntegerType::Add(candidate, IntegerType(1), candidate);
+            }
+            // Small candidates are cheap to check one by one
+            while (candidate.Length() <= 2 && IsProbablePrimeCandidate(candidate))
+            {
+                if (IsProbablePrime(candidate))
+                {
+                    return candidate;
+                }
+                IntegerType::Add(candidate, IntegerType(2), candidate);
+            }
+
+            const std::vector<DigitType>& primes = SmallPrimes();
+            std::vector<char> composite(Window);
+            std::vector<DigitType> offsets;
+            std::vector<char> passed;
+            while (true)
+            {
+                // Candidate + 2 * i is divisible by odd prime p for i = -r / 2 mod p,
+                // where r is the remainder of candidate modulo p
+                std::vector<DigitType> remainders = Remainders(candidate);
+                std::fill(composite.begin(), composite.end(), 0);
+                for (std::size_t k = 1; k < primes.size(); ++k)
+                {
+                    DigitType prime = primes[k];
+                    DigitType start = (prime - remainders[k]) % prime * ((prime + 1) / 2) % prime;
+                    for (DigitType i = start; i < Window; i += prime)
+                    {
+                        composite[i] = 1;
+                    }
+                }
+                offsets.clear();
+                for (DigitType i = 0; i < Window; ++i)
+                {
+                    if (!composite[i])
+                    {
+                        offsets.push_back(i);
+                    }
+                }
+
+                // Batches of candidates are tested in parallel, the first prime is taken
+                std::size_t batch = pool.Size() + 1;
+                for (std::size_t first = 0; first < offsets.size(); first += batch)
+                {
+                    std::size_t count = std::min(batch, offsets.size() - first);
+                    std::vector<IntegerType> candidates(count);
+                    passed.assign(count, 0);
+                    pool.ParallelFor(count, [&](std::size_t i)
+                    {
+                        IntegerType::Add(candidate, IntegerType(ValueType(2 * offsets[first + i])),
+                            candidates[i]);
+                        passed[i] = IsBailliePSWPrime(candidates[i]);
+                    });
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        if (passed[i])
+                        {
+                            return candidates[i];
+                        }
+                    }
+                }
+                IntegerType::Add(candidate, IntegerType(ValueType(2 * Window)), candidate);
+            }
+        }
+
+    private:
+        // Primes below SieveLimit divide sieved candidates,
+        // primes below TrialLimit divide tested numbers
+        static const DigitType SieveLimit = 1 << 16;
+        static const DigitType TrialLimit = 1 << 10;
+        // Number of odd candidates sieved at once
+        static const DigitType Window = 1 << 13;
+
+        // Tells whether candidate fits into the range of exact tests
+        static bool IsProbablePrimeCandidate(const IntegerType& candidate)
+        {
+            return candidate.GetDigit(0) +
+                (candidate.Length() > 1 ? candidate.GetDigit(1) * DigitType(Base) : 0) <
+                DigitType(1) << 32;
+        }
+
+        // Primes below SieveLimit in increasing order
+        static const std::vector<DigitType>& SmallPrimes()
+        {
+            static const std::vector<DigitType> primes = []()
+            {
+                std::vector<char> composite(SieveLimit, 0);
+                std::vector<DigitType> result;
+                for (DigitType i = 2; i < SieveLimit; ++i)
+                {
+                    if (!composite[i])
+                    {
+                        result.push_back(i);
+                        for (DigitType j = i * i; j < SieveLimit; j += i)
+                        {
+                            composite[j] = 1;
+                        }
+                    }
+                }
+                return result;
+            }();
+            return primes;
+        }
+
+        // Products of consecutive small primes, which fit one digit division,
+        // every group is given by its product and the index of its first prime
+        static const std::vector<std::pair<DigitType, std::size_t>>& Groups()
+        {
+            static const std::vector<std::pair<DigitType, std::size_t>> groups = []()
+            {
+                const DigitType limit = std::numeric_limits<IntType>::max() / Base;
+                const std::vector<DigitType>& primes = SmallPrimes();
+                std::vector<std::pair<DigitType, std::size_t>> result;
+                for (std::size_t i = 0; i < primes.size(); ++i)
+                {
+                    if (result.empty() || result.back().first > limit / primes[i])
+                    {
+                        result.emplace_back(primes[i], i);
+                    }
+                    else
+                    {
+                        result.back().first *= primes[i];
+                    }
+                }
+                return result;
+            }();
+            return groups;
+        }
+
+        // Returns remainders of number modulo every small prime
+        static std::vector<DigitType> Remainders(const IntegerType& number)
+        {
+            const std::vector<DigitType>& primes = SmallPrimes();
+            const std::vector<std::pair<DigitType, std::size_t>>& groups = Groups();
+            std::vector<DigitType> remainders(primes.size());
+            for (std::size_t k = 0; k < groups.size(); ++k)
+            {
+                DigitType remainder = IntegerType::SmallRemainder(number, groups[k].first);
+                std::size_t last = k + 1 < groups.size() ? groups[k + 1].second : primes.size();
+                for (std::size_t i = groups[k].second; i < last; ++i)
+                {
+                    remainders[i] = remainder % primes[i];
+                }
+            }
+            return remainders;
+        }
+
+        // Returns the least prime below limit dividing number or zero
+        static DigitType SmallFactor(const IntegerType& number, DigitType limit)
+        {
+            const std::vector<DigitType>& primes = SmallPrimes();
+            const std::vector<std::pair<DigitType, std::size_t>>& groups = Groups();
+            for (std::size_t k = 0; k < groups.size() && primes[groups[k].second] < limit; ++k)
+            {
+                DigitType remainder = IntegerType::SmallRemainder(number, groups[k].first);
+                std::size_t last = k + 1 < groups.size() ? groups[k + 1].second : primes.size();
+                for (std::size_t i = groups[k].second; i < last && primes[i] < limit; ++i)
+                {
+                    if (remainder % primes[i] == 0)
+                    {
+                        return primes[i];
+                    }
+                }
+            }
+            return 0;
+        }
+
+        // Exact test of number below 2^32 by division over small primes
+        static bool IsSmallPrime(DigitType number)
+        {
+            if (number < 2)
+            {
+                return false;
+            }
+            for (DigitType prime : SmallPrimes())
+            {
+                if (prime * prime > number)
+                {
+                    break;
+                }
+                if (number % prime == 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Baillie-PSW test of odd number without small factors
+        static bool IsBailliePSWPrime(const IntegerType& number)
+        {
+            ContextType context(number);
+            return IsStrongProbablePrime(context) && IsStrongLucasProbablePrime(context);
+        }
+
+        // Returns number of the lowest zero bits and removes them from bits
+        static std::size_t RemoveLowZeros(std::vector<bool>& bits)
+        {
+            std::size_t zeros = 0;
+            while (zeros < bits.size() && !bits[zeros])
+            {
+                ++zeros;
+            }
+            bits.erase(bits.begin(), bits.begin() + zeros);
+            return zeros;
+        }
+
+        // Strong probable prime test to base 2: for n - 1 = d * 2^s
+        // either 2^d = 1 or 2^(d * 2^r) = -1 for some r < s
+        static bool IsStrongProbablePrime(ContextType& context)
+        {
+            IntegerType previous;
+            IntegerType::Subtract(context.Modulus(), IntegerType(1), previous);
+            std::vector<bool> bits = ContextType::Bits(previous);
+            std::size_t zeros = RemoveLowZeros(bits);
+
+            ResidueType two = context.Residue(), power = context.Residue();
+            ResidueType minusOne = context.Residue();
+            context.ToResidue(IntegerType(2), two);
+            context.Subtract(minusOne, context.One(), minusOne);
+            context.Power(two, bits, power);
+            if (ContextType::Equal(power, context.One()) || ContextType::Equal(power, minusOne))
+            {
+                return true;
+            }
+            for (std::size_t r = 1; r < zeros; ++r)
+            {
+                context.Multiply(power, power, power);
+                if (ContextType::Equal(power, minusOne))
+                {
+                    return true;
+                }
+                if (ContextType::Equal(power, context.One()))
+                {
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        // Strong Lucas test with P = 1 and Q = (1 - D) / 4, where D is the first
+        // of 5, -7, 9, -11, ... with Jacobi symbol (D / n) = -1: for n + 1 = d * 2^s
+        // either U_d = 0 or V_(d * 2^r) = 0 for some r < s
+        static bool IsStrongLucasProbablePrime(ContextType& context)
+        {
+            const IntegerType& number = context.Modulus();
+            ValueType discriminant = 5;
+            for (int attempt = 0;; ++attempt)
+            {
+                int jacobi = Jacobi(discriminant, number);
+                if (jacobi == -1)
+                {
+                    break;
+                }
+                if (jacobi == 0)
+                {
+                    return IntegerType::Compare(number,
+                        IntegerType(discriminant < 0 ? -discriminant : discriminant)) == 0;
+                }
+                // Squares have no suitable discriminant
+                if (attempt == 10 && IntegerType::IsPerfectSquare(number))
+                {
+                    return false;
+                }
+                discriminant = discriminant > 0 ? -discriminant - 2 : -discriminant + 2;
+            }
+
+            IntegerType next;
+            IntegerType::Add(number, IntegerType(1), next);
+            std::vector<bool> bits = ContextType::Bits(next);
+            std::size_t zeros = RemoveLowZeros(bits);
+
+            ResidueType d = context.Residue(), q = context.Residue();
+            context.ToResidue(IntegerType(discriminant), d);
+            context.ToResidue(IntegerType((1 - discriminant) / 4), q);
+            // U_1 = 1, V_1 = P = 1, Q^1 = Q
+            ResidueType u(context.One()), v(context.One()), power(q);
+            ResidueType product = context.Residue(), term = context.Residue();
+            for (std::size_t i = bits.size() - 1; i-- > 0;)
+            {
+                // U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+                context.Multiply(u, v, u);
+                context.Multiply(v, v, v);
+                context.Add(power, power, term);
+                context.Subtract(v, term, v);
+                context.Multiply(power, power, power);
+                if (bits[i])
+                {
+                    // U_(k+1) = (U_k + V_k) / 2, V_(k+1) = (D U_k + V_k) / 2
+                    context.Multiply(d, u, product);
+                    context.Add(u, v, u);
+                    context.Half(u, u);
+                    context.Add(product, v, v);
+                    context.Half(v, v);
+                    context.Multiply(power, q, power);
+                }
+            }
+            if (ContextType::IsZero(u) || ContextType::IsZero(v))
+            {
+                return true;
+            }
+            for (std::size_t r = 1; r < zeros; ++r)
+            {
+                context.Multiply(v, v, v);
+                context.Add(power, power, term);
+                context.Subtract(v, term, v);
+                if (ContextType::IsZero(v))
+                {
+                    return true;
+                }
+                context.Multiply(power, power, power);
+            }
+            return false;
+        }
+
+        // Returns Jacobi symbol (a / n) for odd positive n
+        static int Jacobi(ValueType a, const IntegerType& n)
+        {
+            int result = 1;
+            DigitType value = a < 0 ? DigitType(-a) : DigitType(a);
+            DigitType remainder = IntegerType::SmallRemainder(n, 8);
+            // (-1 / n) = -1 iff n = 3 (mod 4)
+            if (a < 0 && remainder % 4 == 3)
+            {
+                result = -result;
+            }
+            // (2 / n) = -1 iff n = 3, 5 (mod 8)
+            for (; value != 0 && value % 2 == 0; value /= 2)
+            {
+                if (remainder == 3 || remainder == 5)
+                {
+                    result = -result;
+                }
+            }
+            if (value == 0)
+            {
+                return 0;
+            }
+            // (value / n) = (n / value) unless both are 3 (mod 4)
+            if (value % 4 == 3 && remainder % 4 == 3)
+            {
+                result = -result;
+            }
+            return result * SmallJacobi(IntegerType::SmallRemainder(n, value), value);
+        }
+
+        // Returns Jacobi symbol (a / n) for odd n
+        static int SmallJacobi(DigitType a, DigitType n)
+        {
+            int result = 1;
+            a %= n;
+            while (a != 0)
+            {
+                while (a % 2 == 0)
+                {
+                    a /= 2;
+                    if (n % 8 == 3 || n % 8 == 5)
+                    {
+                        result = -result;
+                    }
+                }
+                std::swap(a, n);
+                if (a % 4 == 3 && n % 4 == 3)
+                {
+                    result = -result;
+                }
+                a %= n;
+            }
+            return n == 1 ? result : 0;
+        }
+    };
+};
+
+#endif
@@ -1,6 +1,11 @@
 #ifndef LONG_ARITHMETIC_LONG_RATIONAL_H_
 #define LONG_ARITHMETIC_LONG_RATIONAL_H_
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
 #include "long_integer.h"
 
 namespace LongArithmetic
@@ -16,6 +21,7 @@ namespace LongArithmetic
         using ValueType = typename IntegerType::ValueType;
         using DigitType = typename IntegerType::DigitType;
         using SignType = typename IntegerType::SignType;
+        using UnsignedValueType = typename IntegerType::UnsignedValueType;
 
         LongRational() : numerator_(0), denominator_(1)
         {
@@ -53,6 +59,8 @@ namespace LongArithmetic
         {
         }
 
+        LongRational(LongRational<Traits, Base>&& rational) = default;
+
         LongRational<Traits, Base>& operator = (const LongRational<Traits, Base>& rational)
         {
             if (this != std::addressof(rational))
@@ -63,25 +71,119 @@ namespace LongArithmetic
             return *this;
         }
 
+        LongRational<Traits, Base>& operator = (LongRational<Traits, Base>&& rational) = default;
+
+        // Values of expressions are written into existing digits
+        template <typename Expression,
+            typename = typename std::enable_if<LongOperand<Expression>::IsExpression &&
+                std::is_same<typename LongOperand<Expression>::ValueType,
+                    LongRational<Traits, Base>>::value>::type>
+        LongRational(const Expression& expression)
+            : LongRational()
+        {
+            expression.EvaluateInto(*this);
+        }
+
+        template <typename Expression>
+        typename std::enable_if<LongOperand<Expression>::IsExpression &&
+            std::is_same<typename LongOperand<Expression>::ValueType,
+                LongRational<Traits, Base>>::value, LongRational<Traits, Base>&>::type
+        operator = (const Expression& expression)
+        {
+            expression.EvaluateInto(*this);
+            return *this;
+        }
 
+        template <typename Operand>
+        LongCompoundType<LongRational<Traits, Base>, Operand> operator += (const Operand& operand)
+        {
+            return *this = LongExpression<AddOperation, LongRational<Traits, Base>, Operand>(*this, operand);
+        }
+
+        template <typename Operand>
+        LongCompoundType<LongRational<Traits, Base>, Operand> operator -= (const Operand& operand)
+        {
+            return *this = LongExpression<SubtractOperation, LongRational<Traits, Base>, Operand>(*this, operand);
+        }
+
+        template <typename Operand>
+        LongCompoundType<LongRational<Traits, Base>, Operand> operator *= (const Operand& operand)
+        {
+            return *this = LongExpression<MultiplyOperation, LongRational<Traits, Base>, Operand>(*this, operand);
+        }
+
+        template <typename Operand>
+        LongCompoundType<LongRational<Traits, Base>, Operand> operator /= (const Operand& operand)
+        {
+            return *this = LongExpression<DivideOperation, LongRational<Traits, Base>, Operand>(*this, operand);
+        }
+
+
+        // Rationals are compared by signs, then by lengths and leading digits
+        // of cross products, which are computed exactly only if they are close
         static int Compare(const LongRational<Traits, Base>& lhs,
             const LongRational<Traits, Base>& rhs)
         {
-            IntegerType leftProduct, rightProduct;
-            IntegerType::Multiply(lhs.numerator_, rhs.denominator_, leftProduct);
-            IntegerType::Multiply(lhs.denominator_, rhs.numerator_, rightProduct);
-            return IntegerType::Compare(leftProduct, rightProduct);
+            int leftSign = lhs.numerator_.IsZero() ? 0 : lhs.numerator_.Sign();
+            int rightSign = rhs.numerator_.IsZero() ? 0 : rhs.numerator_.Sign();
+            if (leftSign != rightSign)
+            {
+                return leftSign > rightSign ? 1 : -1;
+            }
+            if (leftSign == 0)
+            {
+                return 0;
+            }
+
+            // Product of numbers of lengths l and m has length l + m - 1 or l + m
+            IntType leftLength = lhs.numerator_.Length() + rhs.denominator_.Length();
+            IntType rightLength = rhs.numerator_.Length() + lhs.denominator_.Length();
+            if (leftLength > rightLength + 1)
+            {
+                return leftSign;
+            }
+            if (rightLength > leftLength + 1)
+            {
+                return -leftSign;
+            }
+
+            // Approximations of cross products by leading digits are far more
+            // precise than tolerance
+            IntType leftExponent, rightExponent;
+            double left = Leading(lhs.numerator_, leftExponent) *
+                Leading(rhs.denominator_, rightExponent);
+            leftExponent += rightExponent;
+            IntType exponent;
+            double right = Leading(rhs.numerator_, rightExponent) *
+                Leading(lhs.denominator_, exponent);
+            rightExponent += exponent;
+            double ratio = left / right * std::pow(double(Base), double(leftExponent - rightExponent));
+            const double tolerance = 1e-9;
+            if (ratio > 1 + tolerance)
+            {
+                return leftSign;
+            }
+            if (ratio < 1 - tolerance)
+            {
+                return -leftSign;
+            }
+
+            IntegerType difference;
+            IntegerType::Multiply(lhs.numerator_, rhs.denominator_, difference);
+            IntegerType::SubMul(lhs.denominator_, rhs.numerator_, difference);
+            return difference.IsZero() ? 0 : difference.Sign();
         }
 
         static void Add(const LongRational<Traits, Base>& rational,
             const LongRational<Traits, Base>& summand,
             LongRational<Traits, Base>& result)
         {
-            IntegerType leftProduct, rightProduct;
-            IntegerType::Multiply(rational.numerator_, summand.denominator_, leftProduct);
-            IntegerType::Multiply(rational.denominator_, summand.numerator_, rightProduct);
-            IntegerType::Add(leftProduct, rightProduct, result.numerator_);
-            IntegerType::Multiply(rational.denominator_, summand.denominator_, result.denominator_);
+            IntegerType numerator, denominator;
+            IntegerType::Multiply(rational.numerator_, summand.denominator_, numerator);
+            IntegerType::AddMul(rational.denominator_, summand.numerator_, numerator);
+            IntegerType::Multiply(rational.denominator_, summand.denominator_, denominator);
+            result.numerator_ = std::move(numerator);
+            result.denominator_ = std::move(denominator);
             result.Normalize(true);
         }
 
@@ -89,11 +191,12 @@ namespace LongArithmetic
             const LongRational<Traits, Base>& subtrahend,
             LongRational<Traits, Base>& result)
         {
-            IntegerType leftProduct, rightProduct;
-            IntegerType::Multiply(rational.numerator_, subtrahend.denominator_, leftProduct);
-            IntegerType::Multiply(rational.denominator_, subtrahend.numerator_, rightProduct);
-            IntegerType::Subtract(leftProduct, rightProduct, result.numerator_);
-            IntegerType::Multiply(rational.denominator_, subtrahend.denominator_, result.denominator_);
+            IntegerType numerator, denominator;
+            IntegerType::Multiply(rational.numerator_, subtrahend.denominator_, numerator);
+            IntegerType::SubMul(rational.denominator_, subtrahend.numerator_, numerator);
+            IntegerType::Multiply(rational.denominator_, subtrahend.denominator_, denominator);
+            result.numerator_ = std::move(numerator);
+            result.denominator_ = std::move(denominator);
             result.Normalize(true);
         }
 
@@ -112,13 +215,198 @@ namespace LongArithmetic
             const LongRational<Traits, Base>& divisor,
             LongRational<Traits, Base>& result)
         {
-            IntegerType up_product, down_product;
-            IntegerType::Multiply(rational.numerator_, divisor.denominator_, up_product);
-            IntegerType::Multiply(rational.denominator_, divisor.numerator_, down_product);
-            result.numerator_ = up_product, result.denominator_ = down_product;
+            if (divisor.numerator_.IsZero())
+            {
+                throw std::domain_error("Division by zero");
+            }
+            // Common divisors of numerators and of denominators are cancelled
+            // in advance, so quotient of reduced fractions is reduced
+            IntegerType up_divisor = GCD(rational.numerator_, divisor.numerator_);
+            IntegerType down_divisor = GCD(rational.denominator_, divisor.denominator_);
+            IntegerType lhs, rhs, up_product, down_product;
+            IntegerType::DivideExact(rational.numerator_, up_divisor, lhs);
+            IntegerType::DivideExact(divisor.denominator_, down_divisor, rhs);
+            IntegerType::Multiply(lhs, rhs, up_product);
+            IntegerType::DivideExact(rational.denominator_, down_divisor, lhs);
+            IntegerType::DivideExact(divisor.numerator_, up_divisor, rhs);
+            IntegerType::Multiply(lhs, rhs, down_product);
+            result.numerator_.Swap(up_product);
+            result.denominator_.Swap(down_product);
             result.Normalize(false);
         }
 
+        // Function writes the closest to rational fraction with denominator not exceeding
+        // maxDenominator into result, which is a convergent or a semiconvergent
+        // of continued fraction of rational. Partial quotients are found by Lehmer's
+        // method from leading digits of remainders, which is applied recursively
+        // to halves of leading digits, so long remainders are updated once per
+        // many quotients by multiplications of long numbers
+        static void LimitDenominator(const LongRational<Traits, Base>& rational,
+            const IntegerType& maxDenominator,
+            LongRational<Traits, Base>& result)
+        {
+            if (IntegerType::Compare(maxDenominator, IntegerType(1)) < 0)
+            {
+                throw std::invalid_argument("Maximal denominator must be positive");
+            }
+            if (IntegerType::Compare(rational.denominator_, maxDenominator) <= 0)
+            {
+                result = rational;
+                return;
+            }
+            SignType sign = rational.numerator_.Sign();
+            IntegerType numerator(rational.numerator_);
+            numerator.Sign() = 1;
+            const IntegerType& denominator = rational.denominator_;
+
+            // Convergents precede the complete quotient n / d
+            Convergents convergents;
+            IntegerType n(numerator), d(denominator);
+            IntegerType quotient, remainder;
+            bool finished = false;
+            while (!finished)
+            {
+                // Quotients shared by bounds of n / d found from leading digits
+                // are quotients of n / d
+                SizeType precision = 2 * maxDenominator.Length() + 2;
+                if (d.Length() > precision)
+                {
+                    IntegerType lowerN, lowerD, upperN, upperD;
+                    IntegerType::ShiftRight(n, d.Length() - precision, lowerN);
+                    IntegerType::ShiftRight(d, d.Length() - precision, upperD);
+                    IntegerType::Add(upperD, 1, lowerD);
+                    IntegerType::Add(lowerN, 1, upperN);
+                    Convergents found;
+                    if (SharedQuotients(lowerN, lowerD, upperN, upperD, true,
+                        maxDenominator, convergents, found, finished) > 0)
+                    {
+                        Advance(found, n, d);
+                        continue;
+                    }
+                    if (finished)
+                    {
+                        break;
+                    }
+                }
+                IntegerType::DivMod(n, d, quotient, remainder);
+                finished = !NextConvergent(quotient, maxDenominator, convergents);
+                n.Swap(d);
+                d.Swap(remainder);
+            }
+
+            const IntegerType& p0 = convergents.p0;
+            const IntegerType& q0 = convergents.q0;
+            IntegerType& p1 = convergents.p1;
+            IntegerType& q1 = convergents.q1;
+            // Semiconvergent (p0 + k * p1) / (q0 + k * q1) with the largest k
+            // competes with the last convergent p1 / q1
+            IntegerType k, p, q, error, lastError;
+            IntegerType::Subtract(maxDenominator, q0, k);
+            IntegerType::Divide(k, q1, k);
+            IntegerType::Multiply(k, p1, p);
+            IntegerType::Add(p, p0, p);
+            IntegerType::Multiply(k, q1, q);
+            IntegerType::Add(q, q0, q);
+            Residual(p, q, numerator, denominator, error);
+            Residual(p1, q1, numerator, denominator, lastError);
+            IntegerType::Multiply(error, q1, error);
+            IntegerType::Multiply(lastError, q, lastError);
+            if (IntegerType::Compare(lastError, error) <= 0)
+            {
+                p.Swap(p1);
+                q.Swap(q1);
+            }
+            if (!p.IsZero())
+            {
+                p.Sign() *= sign;
+            }
+            result.numerator_.Swap(p);
+            result.denominator_.Swap(q);
+        }
+
+        // Operations with native integers multiply only by native integers,
+        // find common divisors of native integers and update numerators in place
+
+        template <typename Native>
+        static LongNativeType<Native, int>
+        Compare(const LongRational<Traits, Base>& lhs, Native rhs)
+        {
+            return IntegerType::CompareProduct(lhs.numerator_, lhs.denominator_, rhs);
+        }
+
+        // Sum of normalized rational and integer needs no reduction
+        template <typename Native>
+        static LongNativeType<Native>
+        Add(const LongRational<Traits, Base>& rational,
+            Native summand,
+            LongRational<Traits, Base>& result)
+        {
+            if (std::addressof(result) != std::addressof(rational))
+            {
+                result = rational;
+            }
+            IntegerType::AddMul(result.denominator_, summand, result.numerator_);
+        }
+
+        template <typename Native>
+        static LongNativeType<Native>
+        Subtract(const LongRational<Traits, Base>& rational,
+            Native subtrahend,
+            LongRational<Traits, Base>& result)
+        {
+            if (std::addressof(result) != std::addressof(rational))
+            {
+                result = rational;
+            }
+            IntegerType::SubMul(result.denominator_, subtrahend, result.numerator_);
+        }
+
+        template <typename Native>
+        static LongNativeType<Native>
+        Multiply(const LongRational<Traits, Base>& rational,
+            Native multiplier,
+            LongRational<Traits, Base>& result)
+        {
+            if (multiplier == 0)
+            {
+                result.numerator_ = IntegerType(0);
+                result.denominator_ = IntegerType(1);
+                return;
+            }
+            // Common divisor of multiplier and denominator is cancelled in advance
+            UnsignedValueType magnitude = IntegerType::NativeMagnitude(multiplier);
+            UnsignedValueType divisor = std::gcd(magnitude,
+                IntegerType::SmallRemainder(rational.denominator_, magnitude));
+            IntegerType::Multiply(rational.numerator_, magnitude / divisor, result.numerator_);
+            IntegerType::Divide(rational.denominator_, divisor, result.denominator_);
+            if (multiplier < 0 && !result.numerator_.IsZero())
+            {
+                result.numerator_.Sign() *= -1;
+            }
+        }
+
+        template <typename Native>
+        static LongNativeType<Native>
+        Divide(const LongRational<Traits, Base>& rational,
+            Native divisor,
+            LongRational<Traits, Base>& result)
+        {
+            if (divisor == 0)
+            {
+                throw std::domain_error("Division by zero");
+            }
+            // Common divisor of divisor and numerator is cancelled in advance
+            UnsignedValueType magnitude = IntegerType::NativeMagnitude(divisor);
+            UnsignedValueType common = std::gcd(magnitude,
+                IntegerType::SmallRemainder(rational.numerator_, magnitude));
+            IntegerType::Divide(rational.numerator_, common, result.numerator_);
+            IntegerType::Multiply(rational.denominator_, magnitude / common, result.denominator_);
+            if (divisor < 0 && !result.numerator_.IsZero())
+            {
+                result.numerator_.Sign() *= -1;
+            }
+        }
+
         friend std::istream& operator >> (std::istream& in, LongRational<Traits, Base>& rational)
         {
             std::string buffer;
@@ -137,13 +425,11 @@ namespace LongArithmetic
         friend std::ostream& operator << (std::ostream& out,
             const LongRational<Traits, Base>& rational)
         {
-            LongRational<Traits, Base> rational_copy(rational);
-            rational_copy.Normalize(true);
-            if (!IntegerType::Compare(rational_copy.numerator_, IntegerType(0)) ||
-                !IntegerType::Compare(rational_copy.denominator_, IntegerType(1)))
-                return out << rational_copy.numerator_;
+            // Rationals are kept reduced, so they are printed as they are
+            if (IntegerType::Compare(rational.denominator_, 1) == 0)
+                return out << rational.numerator_;
             else
-                return out << rational_copy.numerator_ << '/' << rational_copy.denominator_;
+                return out << rational.numerator_ << '/' << rational.denominator_;
         }
 
         void Normalize(bool reduce)
@@ -159,19 +445,19 @@ namespace LongArithmetic
             if (reduce)
             {
                 IntegerType divisor = GCD(numerator_, denominator_);
-                IntegerType::Divide(numerator_, divisor, numerator_);
-                IntegerType::Divide(denominator_, divisor, denominator_);
+                IntegerType::DivideExact(numerator_, divisor, numerator_);
+                IntegerType::DivideExact(denominator_, divisor, denominator_);
             }
             numerator_.Sign() *= denominator_.Sign();
             denominator_.Sign() *= denominator_.Sign();
         }
 
-        IntegerType Numerator() const
+        const IntegerType& Numerator() const
         {
             return numerator_;
         }
 
-        IntegerType Denominator() const
+        const IntegerType& Denominator() const
         {
             return denominator_;
         }
@@ -187,6 +473,174 @@ namespace LongArithmetic
         }
 
     private:
+        // Fractions with shorter denominators are expanded without recursion
+        static const SizeType LehmerLength = 16;
+
+        // Returns leading digits of magnitude of number and writes
+        // the number of remaining digits into exponent
+        static double Leading(const IntegerType& number, IntType& exponent)
+        {
+            const IntType leadingDigits = 3;
+            IntType length = number.Length();
+            IntType last = std::max<IntType>(length - leadingDigits, 0);
+            double leading = 0;
+            for (IntType i = length - 1; i >= last; --i)
+            {
+                leading = leading * Base + number.GetDigit(i);
+            }
+            exponent = last;
+            return leading;
+        }
+
+        // Two consecutive convergents p0 / q0 and p1 / q1 of continued fraction,
+        // complete quotient x following them gives (p1 * x + p0) / (q1 * x + q0)
+        struct Convergents
+        {
+            Convergents() : p0(0), q0(1), p1(1), q1(0)
+            {
+            }
+
+            IntegerType p0, q0, p1, q1;
+        };
+
+        // Appends partial quotient to convergents
+        static void Append(const IntegerType& quotient, Convergents& convergents)
+        {
+            IntegerType::AddMul(quotient, convergents.p1, convergents.p0);
+            IntegerType::AddMul(quotient, convergents.q1, convergents.q0);
+            convergents.p0.Swap(convergents.p1);
+            convergents.q0.Swap(convergents.q1);
+        }
+
+        // Appends partial quotient to convergents unless the new denominator
+        // exceeds maxDenominator, returns whether it was appended
+        static bool NextConvergent(const IntegerType& quotient,
+            const IntegerType& maxDenominator,
+            Convergents& convergents)
+        {
+            IntegerType denominator(convergents.q0);
+            IntegerType::AddMul(quotient, convergents.q1, denominator);
+            if (IntegerType::Compare(denominator, maxDenominator) > 0)
+            {
+                return false;
+            }
+            Append(quotient, convergents);
+            return true;
+        }
+
+        // Appends partial quotients with convergents next to convergents
+        static void Compose(const Convergents& next, Convergents& convergents)
+        {
+            Convergents product;
+            IntegerType::Multiply(convergents.p1, next.p0, product.p0);
+            IntegerType::AddMul(convergents.p0, next.q0, product.p0);
+            IntegerType::Multiply(convergents.q1, next.p0, product.q0);
+            IntegerType::AddMul(convergents.q0, next.q0, product.q0);
+            IntegerType::Multiply(convergents.p1, next.p1, product.p1);
+            IntegerType::AddMul(convergents.p0, next.q1, product.p1);
+            IntegerType::Multiply(convergents.q1, next.p1, product.q1);
+            IntegerType::AddMul(convergents.q0, next.q1, product.q1);
+            std::swap(convergents, product);
+        }
+
+        // Appends partial quotients shared by fractions aN / aD and bN / bD to
+        // convergents and found, and writes complete quotients which follow them
+        // into fractions, ascending tells whether aN / aD <= bN / bD. Quotients
+        // shared by bounds of fractions found from the leading halves of their digits
+        // are shared by fractions, so they are found recursively. Returns number
+        // of found quotients, finished is set if the next shared quotient makes
+        // denominator of convergents exceed maxDenominator
+        static SizeType SharedQuotients(IntegerType& aN, IntegerType& aD,
+            IntegerType& bN, IntegerType& bD, bool ascending,
+            const IntegerType& maxDenominator,
+            Convergents& convergents, Convergents& found,
+            bool& finished)
+        {
+            SizeType steps = 0;
+            IntegerType quotient, remainder, bQuotient, bRemainder;
+            while (!finished && !aD.IsZero() && !bD.IsZero())
+            {
+                SizeType length = std::min(aD.Length(), bD.Length());
+                if (length > LehmerLength)
+                {
+                    SizeType shift = length / 2;
+                    IntegerType& lowN = ascending ? aN : bN;
+                    IntegerType& lowD = ascending ? aD : bD;
+                    IntegerType& highN = ascending ? bN : aN;
+                    IntegerType& highD = ascending ? bD : aD;
+                    IntegerType lowerN, lowerD, upperN, upperD;
+                    IntegerType::ShiftRight(lowN, shift, lowerN);
+                    IntegerType::ShiftRight(lowD, shift, lowerD);
+                    IntegerType::Add(lowerD, 1, lowerD);
+                    IntegerType::ShiftRight(highN, shift, upperN);
+                    IntegerType::Add(upperN, 1, upperN);
+                    IntegerType::ShiftRight(highD, shift, upperD);
+                    Convergents half;
+                    SizeType count = SharedQuotients(lowerN, lowerD, upperN, upperD, true,
+                        maxDenominator, convergents, half, finished);
+                    if (count > 0)
+                    {
+                        Advance(half, aN, aD);
+                        Advance(half, bN, bD);
+                        Compose(half, found);
+                        steps += count;
+                        ascending = ascending != (count % 2 != 0);
+                        continue;
+                    }
+                    if (finished)
+                    {
+                        break;
+                    }
+                }
+                IntegerType::DivMod(aN, aD, quotient, remainder);
+                IntegerType::DivMod(bN, bD, bQuotient, bRemainder);
+                if (IntegerType::Compare(quotient, bQuotient) != 0)
+                {
+                    break;
+                }
+                if (!NextConvergent(quotient, maxDenominator, convergents))
+                {
+                    finished = true;
+                    break;
+                }
+                Append(quotient, found);
+                ++steps;
+                ascending = !ascending;
+                aN.Swap(aD);
+                aD.Swap(remainder);
+                bN.Swap(bD);
+                bD.Swap(bRemainder);
+            }
+            return steps;
+        }
+
+        // Function replaces fraction n / d by its complete quotient following
+        // partial quotients with given convergents,
+        // which is (p0 * d - q0 * n) / (q1 * n - p1 * d)
+        static void Advance(const Convergents& convergents, IntegerType& n, IntegerType& d)
+        {
+            IntegerType nextN, nextD;
+            Residual(convergents.p0, convergents.q0, n, d, nextN);
+            Residual(convergents.p1, convergents.q1, n, d, nextD);
+            n.Swap(nextN);
+            d.Swap(nextD);
+        }
+
+        // Function writes |p * denominator - q * numerator| into result
+        static void Residual(const IntegerType& p, const IntegerType& q,
+            const IntegerType& numerator, const IntegerType& denominator,
+            IntegerType& result)
+        {
+            IntegerType residual;
+            IntegerType::Multiply(p, denominator, residual);
+            IntegerType::SubMul(q, numerator, residual);
+            if (residual.Sign() < 0)
+            {
+                residual.Sign() = 1;
+            }
+            result.Swap(residual);
+        }
+
         static IntegerType GCD(IntegerType lhs, IntegerType rhs)
         {
             IntegerType zero(0);
@@ -207,7 +661,8 @@ namespace LongArithmetic
 
     private:
         IntegerType numerator_;
-        IntegerType denominator_; // Note that always denominator_ > 0
+        // Note that always denominator_ > 0 and it is coprime with numerator_
+        IntegerType denominator_;
     };
 };
 
@@ -0,0 +1,90 @@
+#ifndef LONG_ARITHMETIC_LONG_REDUCTION_H_
+#define LONG_ARITHMETIC_LONG_REDUCTION_H_
+
+#include <iterator>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace LongArithmetic
+{
+    // Reduces values in [first, last) by a balanced binary tree of operations
+    // operation(lhs, rhs, result), so operands of each operation have similar sizes.
+    // Operations of one level of the tree run in parallel on pool, while pairing
+    // of operands does not depend on scheduling and results are deterministic.
+    template <typename Iterator, typename Value, typename Operation>
+    Value TreeReduce(Iterator first, Iterator last,
+        const Value& identity,
+        Operation operation,
+        ThreadPool& pool = ThreadPool::Default())
+    {
+        std::vector<const Value*> items;
+        for (; first != last; ++first)
+        {
+            items.push_back(std::addressof(*first));
+        }
+        if (items.empty())
+        {
+            return identity;
+        }
+        if (items.size() == 1)
+        {
+            return *items[0];
+        }
+
+        std::vector<Value> level((items.size() + 1) / 2);
+        pool.ParallelFor(items.size() / 2, [&](std::size_t i)
+        {
+            operation(*items[2 * i], *items[2 * i + 1], level[i]);
+        });
+        if (items.size() % 2)
+        {
+            level.back() = *items.back();
+        }
+
+        while (level.size() > 1)
+        {
+            std::vector<Value> next((level.size() + 1) / 2);
+            pool.ParallelFor(level.size() / 2, [&](std::size_t i)
+            {
+                operation(level[2 * i], level[2 * i + 1], next[i]);
+            });
+            if (level.size() % 2)
+            {
+                next.back() = std::move(level.back());
+            }
+            level.swap(next);
+        }
+        return std::move(level[0]);
+    }
+
+    // Returns sum of values in [first, last)
+    template <typename Iterator>
+    typename std::iterator_traits<Iterator>::value_type Sum(Iterator first, Iterator last,
+        ThreadPool& pool = ThreadPool::Default())
+    {
+        using Value = typename std::iterator_traits<Iterator>::value_type;
+        return TreeReduce(first, last, Value(0),
+            [](const Value& lhs, const Value& rhs, Value& result)
+            {
+                Value::Add(lhs, rhs, result);
+            },
+            pool);
+    }
+
+    // Returns product of values in [first, last)
+    template <typename Iterator>
+    typename std::iterator_traits<Iterator>::value_type Product(Iterator first, Iterator last,
+        ThreadPool& pool = ThreadPool::Default())
+    {
+        using Value = typename std::iterator_traits<Iterator>::value_type;
+        return TreeReduce(first, last, Value(1),
+            [](const Value& lhs, const Value& rhs, Value& result)
+            {
+                Value::Multiply(lhs, rhs, result);
+            },
+            pool);
+    }
+};
+
+#endif
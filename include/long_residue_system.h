@@ -0,0 +1,252 @@
+#ifndef LONG_ARITHMETIC_LONG_RESIDUE_SYSTEM_H_
+#define LONG_ARITHMETIC_LONG_RESIDUE_SYSTEM_H_
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "long_prepared_divisor.h"
+#include "thread_pool.h"
+
+namespace LongArithmetic
+{
+    // Residue number system of pairwise coprime moduli below 2^32.
+    // Moduli are kept in a product tree, whose nodes are products of their children
+    // with prepared reciprocals. Reduction of a number modulo all moduli descends
+    // the tree taking remainders (remainder tree), reconstruction by Chinese
+    // remainder theorem ascends it combining residues of halves, so both take
+    // a few multiplications of numbers of the size of the tree level per level.
+    // Nodes of every level are processed in parallel
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongResidueSystem
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using PreparedDivisorType = LongPreparedDivisor<Traits, Base>;
+        using SizeType = typename IntegerType::SizeType;
+        using ValueType = typename IntegerType::ValueType;
+        using DigitType = typename IntegerType::DigitType;
+
+        explicit LongResidueSystem(const std::vector<DigitType>& moduli,
+            ThreadPool& pool = ThreadPool::Default())
+            : moduli_(moduli)
+        {
+            if (moduli_.empty())
+            {
+                throw std::invalid_argument("Residue system without moduli");
+            }
+            std::vector<IntegerType> leaves(moduli_.size());
+            for (std::size_t i = 0; i < moduli_.size(); ++i)
+            {
+                if (moduli_[i] < 2 || moduli_[i] > std::numeric_limits<std::uint32_t>::max())
+                {
+                    throw std::invalid_argument("Modulus of residue system is out of range");
+                }
+                leaves[i] = IntegerType(ValueType(moduli_[i]));
+            }
+            BuildTree(leaves, pool);
+            ComputeCoefficients(pool);
+        }
+
+        const std::vector<DigitType>& Moduli() const
+        {
+            return moduli_;
+        }
+
+        // Product of moduli
+        const IntegerType& Modulus() const
+        {
+            return levels_.empty() ? leaves_[0] : levels_.back()[0]->Divisor();
+        }
+
+        // Function writes residues of number modulo every modulus into residues,
+        // residues of negative numbers are non-negative
+        void Reduce(const IntegerType& number, std::vector<DigitType>& residues,
+            ThreadPool& pool = ThreadPool::Default()) const
+        {
+            residues.resize(moduli_.size());
+            if (levels_.empty())
+            {
+                residues[0] = Residue(number, moduli_[0]);
+                return;
+            }
+            std::vector<IntegerType> remainders(1);
+            IntegerType::Mod(number, *levels_.back()[0], remainders[0]);
+            for (std::size_t level = levels_.size() - 1; level-- > 0;)
+            {
+                std::vector<IntegerType> next(levels_[level].size());
+                pool.ParallelFor(next.size(), [&](std::size_t i)
+                {
+                    IntegerType::Mod(remainders[i / 2], *levels_[level][i], next[i]);
+                });
+                remainders.swap(next);
+            }
+            pool.ParallelFor(moduli_.size(), [&](std::size_t i)
+            {
+                residues[i] = Residue(remainders[i / 2], moduli_[i]);
+            });
+        }
+
+        // Function writes integer with given residues into result, which is
+        // in [0, M) or in (-M / 2, M / 2] if symmetric is set, where M is the product
+        // of moduli. Residues must be less than their moduli
+        void Reconstruct(const std::vector<DigitType>& residues, IntegerType& result,
+            bool symmetric = false,
+            ThreadPool& pool = ThreadPool::Default()) const
+        {
+            if (residues.size() != moduli_.size())
+            {
+                throw std::invalid_argument("Number of residues differs from number of moduli");
+            }
+            // Value of node is sum of c_i * M_v / m_i over its leaves, where
+            // c_i = r_i * (M / m_i)^(-1) mod m_i and M_v is product of its leaves
+            std::vector<IntegerType> values(moduli_.size());
+            pool.ParallelFor(moduli_.size(), [&](std::size_t i)
+            {
+                values[i] = IntegerType(ValueType(residues[i] * inverses_[i] % moduli_[i]));
+            });
+            for (std::size_t level = 0; level < levels_.size(); ++level)
+            {
+                std::vector<IntegerType> next(levels_[level].size());
+                pool.ParallelFor(next.size(), [&](std::size_t i)
+                {
+                    if (2 * i + 1 == values.size())
+                    {
+                        next[i] = values[2 * i];
+                        return;
+                    }
+                    IntegerType::Multiply(values[2 * i], Product(level, 2 * i + 1), next[i]);
+                    IntegerType::AddMul(values[2 * i + 1], Product(level, 2 * i), next[i]);
+                });
+                values.swap(next);
+            }
+            if (!levels_.empty())
+            {
+                IntegerType sum;
+                sum.Swap(values[0]);
+                IntegerType::Mod(sum, *levels_.back()[0], values[0]);
+            }
+            if (symmetric)
+            {
+                IntegerType doubled;
+                IntegerType::Add(values[0], values[0], doubled);
+                if (IntegerType::Compare(doubled, Modulus()) > 0)
+                {
+                    IntegerType::Subtract(values[0], Modulus(), values[0]);
+                }
+            }
+            result.Swap(values[0]);
+        }
+
+    private:
+        // Returns residue of integer modulo modulus
+        static DigitType Residue(const IntegerType& number, DigitType modulus)
+        {
+            DigitType residue = IntegerType::SmallRemainder(number, modulus);
+            return number.Sign() < 0 && residue != 0 ? modulus - residue : residue;
+        }
+
+        // Returns inverse of number modulo modulus, which must be coprime with it
+        static DigitType InverseModulo(DigitType number, DigitType modulus)
+        {
+            ValueType previous = 0, current = 1;
+            DigitType lhs = modulus, rhs = number % modulus;
+            while (rhs != 0)
+            {
+                DigitType quotient = lhs / rhs;
+                ValueType next = previous - ValueType(quotient) * current;
+                previous = current;
+                current = next;
+                DigitType remainder = lhs % rhs;
+                lhs = rhs;
+                rhs = remainder;
+            }
+            if (lhs != 1)
+            {
+                throw std::domain_error("Moduli of residue system are not coprime");
+            }
+            return previous < 0 ? DigitType(previous + ValueType(modulus)) : DigitType(previous);
+        }
+
+        // Product of node of tree above leaves, level 0 consists of moduli
+        const IntegerType& Product(std::size_t level, std::size_t i) const
+        {
+            return level == 0 ? leaves_[i] : levels_[level - 1][i]->Divisor();
+        }
+
+        void BuildTree(const std::vector<IntegerType>& leaves, ThreadPool& pool)
+        {
+            leaves_ = leaves;
+            std::size_t count = leaves.size();
+            for (std::size_t level = 0; count > 1; ++level)
+            {
+                std::size_t parents = (count + 1) / 2;
+                std::vector<std::unique_ptr<PreparedDivisorType>> nodes(parents);
+                pool.ParallelFor(parents, [&](std::size_t i)
+                {
+                    IntegerType product;
+                    if (2 * i + 1 == count)
+                    {
+                        product = Product(level, 2 * i);
+                    }
+                    else
+                    {
+                        IntegerType::Multiply(Product(level, 2 * i),
+                            Product(level, 2 * i + 1), product);
+                    }
+                    nodes[i].reset(new PreparedDivisorType(product));
+                });
+                levels_.push_back(std::move(nodes));
+                count = parents;
+            }
+        }
+
+        // Finds inverses of (M / m_i) modulo m_i descending the tree, since
+        // M / M_child = (M / M_parent) * M_sibling is reduced modulo M_child
+        void ComputeCoefficients(ThreadPool& pool)
+        {
+            std::vector<IntegerType> cofactors(1, IntegerType(1));
+            for (std::size_t level = levels_.size(); level-- > 0;)
+            {
+                std::size_t count = level == 0 ? moduli_.size() : levels_[level - 1].size();
+                std::vector<IntegerType> next(count);
+                pool.ParallelFor(count, [&](std::size_t i)
+                {
+                    std::size_t sibling = i ^ 1;
+                    if (sibling >= count)
+                    {
+                        next[i] = cofactors[i / 2];
+                        return;
+                    }
+                    IntegerType product;
+                    IntegerType::Multiply(cofactors[i / 2], Product(level, sibling), product);
+                    if (level == 0)
+                    {
+                        next[i] = IntegerType(ValueType(Residue(product, moduli_[i])));
+                    }
+                    else
+                    {
+                        IntegerType::Mod(product, *levels_[level - 1][i], next[i]);
+                    }
+                });
+                cofactors.swap(next);
+            }
+            inverses_.resize(moduli_.size());
+            for (std::size_t i = 0; i < moduli_.size(); ++i)
+            {
+                inverses_[i] = InverseModulo(Residue(cofactors[i], moduli_[i]), moduli_[i]);
+            }
+        }
+
+    private:
+        std::vector<DigitType> moduli_;
+        std::vector<IntegerType> leaves_;
+        // Nodes of tree above leaves, the last level is the root
+        std::vector<std::vector<std::unique_ptr<PreparedDivisorType>>> levels_;
+        std::vector<DigitType> inverses_;
+    };
+};
+
+#endif
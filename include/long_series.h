@@ -0,0 +1,195 @@
+#ifndef LONG_ARITHMETIC_LONG_SERIES_H_
+#define LONG_ARITHMETIC_LONG_SERIES_H_
+
+#include <cmath>
+
+#include "long_decimal.h"
+#include "thread_pool.h"
+
+namespace LongArithmetic
+{
+    // Evaluation of hypergeometric series by binary splitting.
+    // Series sum_k a(k) * p(0) * ... * p(k) / (q(0) * ... * q(k)) is described by
+    // term(k, p, q, a), which writes p(k), q(k) and a(k) into its arguments.
+    // For range [first, last) splitting finds P = p(first) * ... * p(last - 1),
+    // Q = q(first) * ... * q(last - 1) and T, such that T / Q is the sum of terms
+    // of the range divided by p(0) * ... * p(first - 1) / (q(0) * ... * q(first - 1)).
+    // Halves of ranges are split independently, so upper levels run in parallel
+    template <typename Traits, typename Traits::BaseType Base>
+    class LongSeries
+    {
+    public:
+        using IntegerType = LongInteger<Traits, Base>;
+        using DecimalType = LongDecimal<Traits, Base>;
+        using SizeType = typename IntegerType::SizeType;
+        using ValueType = typename IntegerType::ValueType;
+
+        // Function writes P, Q and T of range [first, last) into p, q and t.
+        // P is not computed if computeP is not set
+        template <typename Term>
+        static void Split(const Term& term, SizeType first, SizeType last,
+            IntegerType& p, IntegerType& q, IntegerType& t,
+            bool computeP = true,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            if (first >= last)
+            {
+                throw std::invalid_argument("Empty range of series");
+            }
+            SplitRange(term, first, last, p, q, t, computeP, ParallelDepth(pool), pool);
+        }
+
+        // Returns pi with digits decimal digits after point computed by Chudnovsky series
+        // pi = 426880 * sqrt(10005) / sum_k (-1)^k (6k)! (13591409 + 545140134 k)
+        // / ((3k)! (k!)^3 640320^(3k))
+        static DecimalType Pi(SizeType digits,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            // Every term adds about 14.18 decimal digits
+            SizeType scale = digits + GuardDigits;
+            SizeType terms = static_cast<SizeType>(scale / 14.181647462725477) + 1;
+            IntegerType p, q, t;
+            Split(ChudnovskyTerm, 0, terms, p, q, t, false, pool);
+
+            // sqrt(10005) * 10^scale
+            IntegerType radicand, root;
+            IntegerType::Multiply(DecimalPower(2 * scale), 10005, radicand);
+            IntegerType::Sqrt(radicand, root);
+            IntegerType numerator, unscaled;
+            IntegerType::Multiply(q, root, numerator);
+            IntegerType::Multiply(numerator, 426880, numerator);
+            IntegerType::Divide(numerator, t, unscaled);
+            return Round(unscaled, scale, digits);
+        }
+
+        // Returns e with digits decimal digits after point computed by series
+        // e = sum_k 1 / k!
+        static DecimalType E(SizeType digits,
+            ThreadPool& pool = ThreadPool::Default())
+        {
+            SizeType scale = digits + GuardDigits;
+            // Number of terms n satisfies log10(n!) > scale
+            SizeType terms = 1;
+            for (double logarithm = 0.0; logarithm <= scale; ++terms)
+            {
+                logarithm += std::log10(static_cast<double>(terms));
+            }
+            IntegerType p, q, t;
+            Split(ETerm, 0, terms, p, q, t, false, pool);
+
+            IntegerType numerator, unscaled;
+            IntegerType::Multiply(t, DecimalPower(scale), numerator);
+            IntegerType::Divide(numerator, q, unscaled);
+            return Round(unscaled, scale, digits);
+        }
+
+    private:
+        // Decimal digits computed beyond requested ones, which absorb truncation errors
+        static const SizeType GuardDigits = 10;
+        // Ranges shorter than this are split sequentially
+        static const SizeType ParallelLength = 64;
+
+        template <typename Term>
+        static void SplitRange(const Term& term, SizeType first, SizeType last,
+            IntegerType& p, IntegerType& q, IntegerType& t,
+            bool computeP, unsigned int parallelDepth, ThreadPool& pool)
+        {
+            if (last - first == 1)
+            {
+                IntegerType a;
+                term(first, p, q, a);
+                IntegerType::Multiply(a, p, t);
+                return;
+            }
+            SizeType middle = first + (last - first) / 2;
+            IntegerType leftP, leftQ, leftT, rightP, rightQ, rightT;
+            if (parallelDepth > 0 && last - first >= ParallelLength)
+            {
+                pool.ParallelFor(2, [&](std::size_t half)
+                {
+                    if (half == 0)
+                    {
+                        SplitRange(term, first, middle, leftP, leftQ, leftT,
+                            true, parallelDepth - 1, pool);
+                    }
+                    else
+                    {
+                        SplitRange(term, middle, last, rightP, rightQ, rightT,
+                            computeP, parallelDepth - 1, pool);
+                    }
+                });
+            }
+            else
+            {
+                SplitRange(term, first, middle, leftP, leftQ, leftT, true, 0, pool);
+                SplitRange(term, middle, last, rightP, rightQ, rightT, computeP, 0, pool);
+            }
+
+            // T = T_left * Q_right + P_left * T_right
+            IntegerType::Multiply(leftT, rightQ, t);
+            IntegerType::AddMul(leftP, rightT, t);
+            IntegerType::Multiply(leftQ, rightQ, q);
+            if (computeP)
+            {
+                IntegerType::Multiply(leftP, rightP, p);
+            }
+        }
+
+        // Depth of splitting up to which halves are split in parallel,
+        // so that every thread of pool gets a subtree
+        static unsigned int ParallelDepth(ThreadPool& pool)
+        {
+            unsigned int depth = 0;
+            while ((1u << depth) < pool.Size() + 1)
+            {
+                ++depth;
+            }
+            return depth;
+        }
+
+        static void ChudnovskyTerm(SizeType k, IntegerType& p, IntegerType& q, IntegerType& a)
+        {
+            if (k == 0)
+            {
+                p = IntegerType(1);
+                q = IntegerType(1);
+            }
+            else
+            {
+                // p(k) = -(6k - 5)(2k - 1)(6k - 1), q(k) = k^3 * 640320^3 / 24
+                IntegerType::Multiply(IntegerType(-ValueType(6 * k - 5)), ValueType(2 * k - 1), p);
+                IntegerType::Multiply(p, ValueType(6 * k - 1), p);
+                IntegerType::Multiply(IntegerType(ValueType(k)), ValueType(k), q);
+                IntegerType::Multiply(q, ValueType(k), q);
+                IntegerType::Multiply(q, ValueType(10939058860032000LL), q);
+            }
+            IntegerType::Multiply(IntegerType(ValueType(545140134)), ValueType(k), a);
+            IntegerType::Add(a, IntegerType(ValueType(13591409)), a);
+        }
+
+        static void ETerm(SizeType k, IntegerType& p, IntegerType& q, IntegerType& a)
+        {
+            p = IntegerType(1);
+            q = IntegerType(k == 0 ? 1 : ValueType(k));
+            a = IntegerType(1);
+        }
+
+        // Returns 10^digits
+        static IntegerType DecimalPower(SizeType digits)
+        {
+            DecimalType power(IntegerType(1), 0);
+            power.Rescale(digits);
+            return power.Unscaled();
+        }
+
+        // Returns unscaled / 10^scale rounded to digits after point
+        static DecimalType Round(const IntegerType& unscaled, SizeType scale, SizeType digits)
+        {
+            DecimalType result(unscaled, scale);
+            result.Rescale(digits);
+            return result;
+        }
+    };
+};
+
+#endif
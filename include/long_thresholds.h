@@ -0,0 +1,14 @@
+#ifndef LONG_ARITHMETIC_LONG_THRESHOLDS_H_
+#define LONG_ARITHMETIC_LONG_THRESHOLDS_H_
+
+// Crossovers of multiplication algorithms.
+// Generated by `make tune` from measurements on the local machine
+namespace LongArithmetic
+{
+    // Length of shorter factor from which products are computed by transform
+    const unsigned int TRANSFORM_MULTIPLY_THRESHOLD = 128;
+    // Length of number from which squares are computed by transform
+    const unsigned int TRANSFORM_SQUARE_THRESHOLD = 96;
+};
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef LONG_ARITHMETIC_LONG_TRANSFORM_H_
+#define LONG_ARITHMETIC_LONG_TRANSFORM_H_
+
+#include <vector>
+
+namespace LongArithmetic
+{
+    // Number theoretic transform modulo prime 29 * 2^57 + 1.
+    // Convolution of sequences is computed exactly while its values stay below
+    // the modulus. Arithmetic is done in Montgomery form with R = 2^64
+    template <typename Traits>
+    class LongTransform
+    {
+    public:
+        using UnsignedValueType = typename Traits::UnsignedValueType;
+        using WideValueType = typename Traits::WideValueType;
+        using SizeType = typename Traits::SizeType;
+        using TransformType = std::vector<UnsignedValueType>;
+
+        static constexpr UnsignedValueType Modulus = 4179340454199820289ULL;
+
+        // Smallest power of two not less than length
+        static SizeType Size(SizeType length)
+        {
+            SizeType size = 1;
+            while (size < length)
+            {
+                size <<= 1;
+            }
+            return size;
+        }
+
+        // Transforms values, size of values must be a power of two.
+        // Results are written in bit-reversed order
+        static void Forward(TransformType& values)
+        {
+            SizeType size = static_cast<SizeType>(values.size());
+            TransformType roots;
+            Roots(Power(PrimitiveRoot, (Modulus - 1) / size), size, roots);
+            UnsignedValueType* pValues = values.data();
+            for (SizeType half = size >> 1, stride = 1; half >= 1; half >>= 1, stride <<= 1)
+            {
+                for (SizeType start = 0; start < size; start += 2 * half)
+                {
+                    for (SizeType j = 0; j < half; ++j)
+                    {
+                        UnsignedValueType u = pValues[start + j];
+                        UnsignedValueType v = pValues[start + j + half];
+                        pValues[start + j] = AddModulo(u, v);
+                        pValues[start + j + half] =
+                            MultiplyModulo(SubtractModulo(u, v), roots[j * stride]);
+                    }
+                }
+            }
+        }
+
+        // Inverts Forward applied to values, multiplied pointwise by count
+        // other transforms. Results are written in natural order
+        static void Inverse(TransformType& values, SizeType count)
+        {
+            SizeType size = static_cast<SizeType>(values.size());
+            TransformType roots;
+            Roots(Power(PrimitiveRoot, Modulus - 1 - (Modulus - 1) / size), size, roots);
+            UnsignedValueType* pValues = values.data();
+            for (SizeType half = 1, stride = size >> 1; half < size; half <<= 1, stride >>= 1)
+            {
+                for (SizeType start = 0; start < size; start += 2 * half)
+                {
+                    for (SizeType j = 0; j < half; ++j)
+                    {
+                        UnsignedValueType u = pValues[start + j];
+                        UnsignedValueType v =
+                            MultiplyModulo(pValues[start + j + half], roots[j * stride]);
+                        pValues[start + j] = AddModulo(u, v);
+                        pValues[start + j + half] = SubtractModulo(u, v);
+                    }
+                }
+            }
+            // Every pointwise product brought factor 1 / R, inverse brought factor size
+            UnsignedValueType scale = Power(size, Modulus - 2);
+            for (SizeType i = 0; i < count; ++i)
+            {
+                scale = MultiplyModulo(scale, Square);
+            }
+            for (SizeType i = 0; i < size; ++i)
+            {
+                pValues[i] = MultiplyModulo(pValues[i], scale);
+            }
+        }
+
+        // Multiplies values by other pointwise
+        static void PointwiseMultiply(TransformType& values, const TransformType& other)
+        {
+            for (SizeType i = 0; i < values.size(); ++i)
+            {
+                values[i] = MultiplyModulo(values[i], other[i]);
+            }
+        }
+
+        // Multiplies values by powers w^(k * i) of root w of unity of order
+        // rows * values.size(), where k is row of values with reversed bits.
+        // Values are a row of matrix of rows rows, whose columns are transformed
+        // by Forward, so that Forward of rows after Twist completes transform
+        // of the whole matrix (four-step method). If inverse is set, powers of
+        // inverse root undo Twist after Inverse of rows before Inverse of columns
+        static void Twist(TransformType& values, SizeType row, SizeType rows, bool inverse)
+        {
+            SizeType reversed = 0;
+            for (SizeType bit = 1, mirror = rows >> 1; bit < rows; bit <<= 1, mirror >>= 1)
+            {
+                if (row & bit)
+                {
+                    reversed |= mirror;
+                }
+            }
+            UnsignedValueType order = UnsignedValueType(rows) * values.size();
+            UnsignedValueType exponent = (Modulus - 1) / order * reversed;
+            if (inverse && exponent != 0)
+            {
+                exponent = Modulus - 1 - exponent;
+            }
+            UnsignedValueType root = Power(PrimitiveRoot, exponent);
+            UnsignedValueType factor = Unit;
+            for (SizeType i = 0; i < values.size(); ++i)
+            {
+                values[i] = MultiplyModulo(values[i], factor);
+                factor = MultiplyModulo(factor, root);
+            }
+        }
+
+    private:
+        // -1 / Modulus modulo 2^64
+        static constexpr UnsignedValueType NegativeInverse()
+        {
+            UnsignedValueType inverse = Modulus;
+            for (int i = 0; i < 5; ++i)
+            {
+                inverse *= 2 - Modulus * inverse;
+            }
+            return 0 - inverse;
+        }
+
+        static constexpr UnsignedValueType NegatedModulus = NegativeInverse();
+        // R modulo Modulus and R^2 modulo Modulus
+        static constexpr UnsignedValueType Unit = (0 - Modulus) % Modulus;
+        static constexpr UnsignedValueType Square =
+            static_cast<UnsignedValueType>(WideValueType(Unit) * Unit % Modulus);
+        static constexpr UnsignedValueType PrimitiveRoot = 3;
+
+        // Returns lhs * rhs / R modulo Modulus
+        static UnsignedValueType MultiplyModulo(UnsignedValueType lhs, UnsignedValueType rhs)
+        {
+            WideValueType product = WideValueType(lhs) * rhs;
+            UnsignedValueType factor = static_cast<UnsignedValueType>(product) * NegatedModulus;
+            UnsignedValueType result = static_cast<UnsignedValueType>(
+                (product + WideValueType(factor) * Modulus) >> 64);
+            return result >= Modulus ? result - Modulus : result;
+        }
+
+        static UnsignedValueType AddModulo(UnsignedValueType lhs, UnsignedValueType rhs)
+        {
+            UnsignedValueType result = lhs + rhs;
+            return result >= Modulus ? result - Modulus : result;
+        }
+
+        static UnsignedValueType SubtractModulo(UnsignedValueType lhs, UnsignedValueType rhs)
+        {
+            return lhs >= rhs ? lhs - rhs : lhs + Modulus - rhs;
+        }
+
+        // Returns Montgomery form of value^exponent for value in usual form
+        static UnsignedValueType Power(UnsignedValueType value, UnsignedValueType exponent)
+        {
+            UnsignedValueType base = MultiplyModulo(value, Square);
+            UnsignedValueType result = Unit;
+            for (; exponent > 0; exponent >>= 1)
+            {
+                if (exponent & 1)
+                {
+                    result = MultiplyModulo(result, base);
+                }
+                base = MultiplyModulo(base, base);
+            }
+            return result;
+        }
+
+        // Writes first size / 2 powers of root given in Montgomery form into roots
+        static void Roots(UnsignedValueType root, SizeType size, TransformType& roots)
+        {
+            roots.resize(size / 2 + 1);
+            roots[0] = Unit;
+            for (SizeType i = 1; i < roots.size(); ++i)
+            {
+                roots[i] = MultiplyModulo(roots[i - 1], root);
+            }
+        }
+    };
+};
+
+#endif
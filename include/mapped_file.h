@@ -0,0 +1,167 @@
+#ifndef LONG_ARITHMETIC_MAPPED_FILE_H_
+#define LONG_ARITHMETIC_MAPPED_FILE_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LongArithmetic
+{
+    // File mapped into memory, whose pages are read by the system on first access
+    // and are not counted as memory of the process. Changes of writable files
+    // are written back by the system
+    class MappedFile
+    {
+    public:
+        enum class Access
+        {
+            ReadOnly,
+            ReadWrite
+        };
+
+        // Maps existing file
+        explicit MappedFile(const std::string& path, Access access = Access::ReadOnly)
+            : descriptor_(-1)
+            , data_(nullptr)
+            , size_(0)
+            , writable_(access == Access::ReadWrite)
+        {
+            descriptor_ = ::open(path.c_str(), writable_ ? O_RDWR : O_RDONLY);
+            if (descriptor_ < 0)
+            {
+                Fail("Can not open file ", path);
+            }
+            struct stat status;
+            if (::fstat(descriptor_, &status) != 0)
+            {
+                Close();
+                Fail("Can not get size of file ", path);
+            }
+            Map(path, static_cast<std::size_t>(status.st_size));
+        }
+
+        // Creates file of given size filled with zeros and maps it for writing
+        MappedFile(const std::string& path, std::size_t size)
+            : descriptor_(-1)
+            , data_(nullptr)
+            , size_(0)
+            , writable_(true)
+        {
+            descriptor_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (descriptor_ < 0)
+            {
+                Fail("Can not create file ", path);
+            }
+            if (::ftruncate(descriptor_, static_cast<off_t>(size)) != 0)
+            {
+                Close();
+                Fail("Can not resize file ", path);
+            }
+            Map(path, size);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator = (const MappedFile&) = delete;
+
+        ~MappedFile()
+        {
+            Close();
+        }
+
+        const char* Data() const
+        {
+            return data_;
+        }
+
+        char* Data()
+        {
+            return data_;
+        }
+
+        std::size_t Size() const
+        {
+            return size_;
+        }
+
+        bool Writable() const
+        {
+            return writable_;
+        }
+
+        // Gives advice of madvise about bytes [offset, offset + length),
+        // which are extended to whole pages
+        void Advise(std::size_t offset, std::size_t length, int advice) const
+        {
+            if (data_ == nullptr || offset >= size_)
+            {
+                return;
+            }
+            std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            std::size_t first = offset / page * page;
+            std::size_t last = std::min(offset + length, size_);
+            ::madvise(data_ + first, last - first, advice);
+        }
+
+    private:
+        void Map(const std::string& path, std::size_t size)
+        {
+            size_ = size;
+            if (size_ == 0)
+            {
+                return;
+            }
+            void* data = ::mmap(nullptr, size_, writable_ ? PROT_READ | PROT_WRITE : PROT_READ,
+                writable_ ? MAP_SHARED : MAP_PRIVATE, descriptor_, 0);
+            if (data == MAP_FAILED)
+            {
+                Close();
+                Fail("Can not map file ", path);
+            }
+            data_ = static_cast<char*>(data);
+            // Files mapped for reading are parsed in order, writable files
+            // are advised by their users. Large pages reduce misses of TLB
+            if (!writable_)
+            {
+                ::madvise(data_, size_, MADV_SEQUENTIAL);
+            }
+#ifdef MADV_HUGEPAGE
+            ::madvise(data_, size_, MADV_HUGEPAGE);
+#endif
+        }
+
+        void Close()
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(data_, size_);
+                data_ = nullptr;
+            }
+            if (descriptor_ >= 0)
+            {
+                ::close(descriptor_);
+                descriptor_ = -1;
+            }
+        }
+
+        static void Fail(const char* message, const std::string& path)
+        {
+            throw std::runtime_error(message + path + ": " + std::strerror(errno));
+        }
+
+    private:
+        int descriptor_;
+        char* data_;
+        std::size_t size_;
+        bool writable_;
+    };
+};
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef LONG_ARITHMETIC_THREAD_POOL_H_
+#define LONG_ARITHMETIC_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LongArithmetic
+{
+    // Fixed set of worker threads running independent parts of computations
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(unsigned int threads)
+            : stop_(false)
+        {
+            for (unsigned int i = 0; i < threads; ++i)
+            {
+                workers_.emplace_back([this]() { Work(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            condition_.notify_all();
+            for (std::thread& worker : workers_)
+            {
+                worker.join();
+            }
+        }
+
+        // Pool with a worker for every hardware thread except the calling one
+        static ThreadPool& Default()
+        {
+            static ThreadPool pool(std::thread::hardware_concurrency() > 1 ?
+                std::thread::hardware_concurrency() - 1 : 0);
+            return pool;
+        }
+
+        unsigned int Size() const
+        {
+            return static_cast<unsigned int>(workers_.size());
+        }
+
+        // Runs task(i) for every i in [0, count) and waits for completion.
+        // The calling thread takes part in the work, so nested calls from tasks
+        // can not deadlock. The first exception thrown by a task is rethrown.
+        template <typename Function>
+        void ParallelFor(std::size_t count, Function task)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            if (count == 1 || workers_.empty())
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    task(i);
+                }
+                return;
+            }
+
+            struct Loop
+            {
+                std::function<void(std::size_t)> task;
+                std::size_t count;
+                std::atomic<std::size_t> next;
+                std::atomic<std::size_t> completed;
+                std::exception_ptr error;
+                std::mutex mutex;
+                std::condition_variable done;
+
+                void Run()
+                {
+                    std::size_t i;
+                    while ((i = next.fetch_add(1)) < count)
+                    {
+                        try
+                        {
+                            task(i);
+                        }
+                        catch (...)
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            if (!error)
+                            {
+                                error = std::current_exception();
+                            }
+                        }
+                        if (completed.fetch_add(1) + 1 == count)
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            done.notify_all();
+                        }
+                    }
+                }
+            };
+
+            std::shared_ptr<Loop> loop = std::make_shared<Loop>();
+            loop->task = task;
+            loop->count = count;
+            loop->next = 0;
+            loop->completed = 0;
+            std::size_t helpers = std::min<std::size_t>(workers_.size(), count - 1);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (std::size_t i = 0; i < helpers; ++i)
+                {
+                    tasks_.emplace_back([loop]() { loop->Run(); });
+                }
+            }
+            condition_.notify_all();
+
+            loop->Run();
+            {
+                std::unique_lock<std::mutex> lock(loop->mutex);
+                loop->done.wait(lock, [&loop]() { return loop->completed == loop->count; });
+            }
+            if (loop->error)
+            {
+                std::rethrow_exception(loop->error);
+            }
+        }
+
+    private:
+        void Work()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    condition_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+                    if (tasks_.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+    private:
+        std::vector<std::thread> workers_;
+        std::deque<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stop_;
+    };
+};
+
+#endif
@@ -9,7 +9,6 @@ int Run()
     using Integer = LongArithmetic::Integer;
 
     Integer currentProduct(1);
-    Integer two(2);
     Integer resultingProduct(1);
 
     out << "Enter degree: ";
@@ -18,7 +17,7 @@ int Run()
 
     for (int power = degree; power > 0; --power)
     {
-        Integer::Multiply(currentProduct, two, resultingProduct);
+        Integer::Multiply(currentProduct, 2, resultingProduct);
         currentProduct = resultingProduct;
     }
 
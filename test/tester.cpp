@@ -1,18 +1,43 @@
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
 #include "long_arithmetic.h"
 
 
 using Integer = LongArithmetic::Integer;
+using Rational = LongArithmetic::Rational;
+using ContinuedFraction = LongArithmetic::ContinuedFraction;
+using Float = LongArithmetic::Float;
+using Decimal = LongArithmetic::Decimal;
+using PreparedDivisor = LongArithmetic::PreparedDivisor;
+using PreparedMultiplier = LongArithmetic::PreparedMultiplier;
+using Accumulator = LongArithmetic::Accumulator;
+using Series = LongArithmetic::Series;
+using Matrix = LongArithmetic::Matrix;
+using Parser = LongArithmetic::Parser;
+using DiskNumber = LongArithmetic::DiskNumber;
+using ResidueSystem = LongArithmetic::ResidueSystem;
+using ModularContext = LongArithmetic::ModularContext;
+using Primality = LongArithmetic::Primality;
+using SharedInteger = LongArithmetic::SharedInteger;
+using SharedRational = LongArithmetic::SharedRational;
+using LongArithmetic::RoundingMode;
 
 Integer Factorial(int n)
 {
     assert(n >= 0);
     Integer currentProduct(1);
-    Integer two(2);
     Integer resultingProduct(1);
     for (int i = 1; i <= n; ++i)
     {
-        Integer::Multiply(currentProduct, Integer(i), resultingProduct);
+        Integer::Multiply(currentProduct, i, resultingProduct);
         currentProduct = resultingProduct;
     }
     return resultingProduct;
@@ -27,7 +52,7 @@ Integer Binomial(int n, int k)
     Integer binomial;
     Integer product;
     Integer::Multiply(Factorial(k), Factorial(n-k), product);
-    Integer::Divide(Factorial(n), product, binomial);
+    Integer::DivideExact(Factorial(n), product, binomial);
     return binomial;
 }
 
@@ -61,6 +86,1527 @@ bool RunTest(std::ostream& out, int n)
 
 }
 
+bool RunRootTest(std::ostream& out, int n)
+{
+    // This test checks that roots of x^k, x^k - 1 and x^k + 1 are found exactly
+    Integer one(1);
+    Integer x;
+    Integer::Add(Factorial(n), Integer(n + 1), x);
+    Integer previous;
+    Integer::Subtract(x, one, previous);
+    for (int degree = 2; degree <= 5; ++degree)
+    {
+        Integer power, lower, upper;
+        Integer::Power(x, degree, power);
+        Integer::Subtract(power, one, lower);
+        Integer::Add(power, one, upper);
+
+        Integer root, lowerRoot, upperRoot;
+        Integer::Root(power, degree, root);
+        Integer::Root(lower, degree, lowerRoot);
+        Integer::Root(upper, degree, upperRoot);
+        bool valid = Integer::Compare(root, x) == 0 &&
+            Integer::Compare(lowerRoot, previous) == 0 &&
+            Integer::Compare(upperRoot, x) == 0 &&
+            Integer::IsPerfectPower(power) &&
+            !Integer::IsPerfectPower(upper) &&
+            Integer::IsPerfectSquare(power) == (degree % 2 == 0);
+
+        Integer sqrt, surplus;
+        Integer::SqrtRem(upper, sqrt, surplus);
+        Integer square, check, doubledSqrt;
+        Integer::Multiply(sqrt, sqrt, square);
+        Integer::Add(square, surplus, check);
+        Integer::Add(sqrt, sqrt, doubledSqrt);
+        valid &= Integer::Compare(check, upper) == 0 &&
+            Integer::Compare(surplus, Integer(0)) >= 0 &&
+            Integer::Compare(surplus, doubledSqrt) <= 0;
+        if (!valid)
+        {
+            out << "Test failed: root of degree " << degree
+                << " of (" << x << ")^" << degree << '\n';
+            return false;
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunFloatTest(std::ostream& out, unsigned int precision)
+{
+    // This test checks directed rounding of 1/3, sqrt(2) and 1 + Base^-1000
+    Rational third(1, 3);
+    Float lower(third, precision, RoundingMode::TowardZero);
+    Float upper(third, precision, RoundingMode::Upward);
+    Float difference(Integer(0), 0, precision + 1);
+    Float::Subtract(upper, lower, difference);
+    bool valid = Rational::Compare(lower.ToRational(), third) < 0 &&
+        Rational::Compare(third, upper.ToRational()) < 0 &&
+        Float::Compare(difference, Float(Integer(1), -Float::ExponentType(precision))) == 0;
+
+    Float two(Integer(2), 0, precision);
+    Float root(Integer(0), 0, precision, RoundingMode::TowardZero);
+    Float::Sqrt(two, root);
+    Float ulp(Integer(1), root.Exponent() + root.Mantissa().Length() - precision);
+    Float nextRoot(Integer(0), 0, precision + 2);
+    Float::Add(root, ulp, nextRoot);
+    Rational square, nextSquare;
+    Rational::Multiply(root.ToRational(), root.ToRational(), square);
+    Rational::Multiply(nextRoot.ToRational(), nextRoot.ToRational(), nextSquare);
+    valid &= Rational::Compare(square, Rational(2)) < 0 &&
+        Rational::Compare(nextSquare, Rational(2)) > 0;
+
+    Float one(Integer(1), 0, precision);
+    Float tiny(Integer(1), -1000);
+    Float nearest(Integer(0), 0, precision);
+    Float up(Integer(0), 0, precision, RoundingMode::Upward);
+    Float down(Integer(0), 0, precision, RoundingMode::Downward);
+    Float::Add(one, tiny, nearest);
+    Float::Add(one, tiny, up);
+    Float::Subtract(one, tiny, down);
+    valid &= Float::Compare(nearest, one) == 0 &&
+        Float::Compare(up, one) > 0 &&
+        Float::Compare(down, one) < 0 &&
+        up.Mantissa().Length() == precision &&
+        down.Mantissa().Length() == precision;
+
+    // Operands with close leading digits cancel, so their difference must be exact
+    Float::ExponentType shift = Float::ExponentType(precision) + 6;
+    Integer nines;
+    Integer::Power(Integer(LongArithmetic::DEFAULT_NUMBER_BASE), shift + 2, nines);
+    Integer::Subtract(nines, Integer(1), nines);
+    Float near(nines, -shift, precision + 10);
+    Float cancelled(Integer(0), 0, precision);
+    Float::Subtract(Float(Integer(1), 2, precision + 10), near, cancelled);
+    valid &= Float::Compare(cancelled, Float(Integer(1), -shift)) == 0;
+    if (!valid)
+    {
+        out << "Test failed: rounding with precision " << precision << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunSharedTest(std::ostream& out, int n)
+{
+    // This test checks that modification of a copy does not affect shared digits
+    SharedInteger product(1);
+    for (int i = 1; i <= n; ++i)
+    {
+        SharedInteger::Multiply(product, SharedInteger(i), product);
+    }
+    SharedInteger copy(product);
+    SharedInteger assigned;
+    assigned = product;
+    SharedInteger::Add(copy, SharedInteger(1), copy);
+    SharedInteger::Divide(assigned, SharedInteger(n), assigned);
+
+    std::stringstream expected, actual;
+    expected << Factorial(n) << ' ' << Factorial(n - 1);
+    actual << product << ' ' << assigned;
+    SharedInteger difference;
+    SharedInteger::Subtract(copy, product, difference);
+
+    SharedRational rational(product, copy);
+    SharedInteger numerator = rational.Numerator();
+    SharedInteger::Subtract(numerator, SharedInteger(1), numerator);
+
+    // Copies of a number left by move may be assigned again
+    SharedInteger moved(product);
+    SharedInteger taken(std::move(moved));
+    SharedInteger fromMoved(moved), reassigned(7);
+    reassigned = moved;
+    reassigned = taken;
+    fromMoved = taken;
+    if (expected.str() != actual.str() ||
+        SharedInteger::Compare(difference, SharedInteger(1)) != 0 ||
+        SharedInteger::Compare(rational.Numerator(), product) != 0 ||
+        SharedInteger::Compare(reassigned, product) != 0 ||
+        SharedInteger::Compare(fromMoved, product) != 0)
+    {
+        out << "Test failed: shared copies of " << n << "!\n";
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunReductionTest(std::ostream& out, int n)
+{
+    // This test checks tree reductions against the alternating binomial sum
+    // and the harmonic number against sequential summation
+    std::vector<Integer> factors;
+    std::vector<Integer> binomials;
+    std::vector<Rational> fractions;
+    Rational harmonic(0);
+    for (int k = 1; k <= n; ++k)
+    {
+        factors.push_back(Integer(k));
+        fractions.push_back(Rational(1, k));
+        Rational::Add(harmonic, fractions.back(), harmonic);
+    }
+    for (int k = 0; k <= n; ++k)
+    {
+        binomials.push_back(Binomial(n, k));
+        binomials.back().Sign() = (k % 2 && !binomials.back().IsZero()) ? -1 : 1;
+    }
+    Integer product = LongArithmetic::Product(factors.begin(), factors.end());
+    Integer sum = LongArithmetic::Sum(binomials.begin(), binomials.end());
+    Rational harmonicSum = LongArithmetic::Sum(fractions.begin(), fractions.end());
+    if (Integer::Compare(product, Factorial(n)) != 0 ||
+        Integer::Compare(sum, Integer(0)) != 0 ||
+        Rational::Compare(harmonicSum, harmonic) != 0)
+    {
+        out << "Test failed: tree reduction of " << n << " values\n";
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunDecimalTest(std::ostream& out, int padding)
+{
+    // This test checks rounding of decimals to integers in every rounding mode,
+    // padding moves discarded digits across digits of Base
+    const char* values[] = {"5.5", "2.5", "1.6", "1.1", "1.0",
+        "-1.0", "-1.1", "-1.6", "-2.5", "-5.5"};
+    const RoundingMode modes[] = {RoundingMode::ToNearest, RoundingMode::ToNearestAway,
+        RoundingMode::TowardZero, RoundingMode::Upward, RoundingMode::Downward};
+    const int expected[][5] = {{6, 6, 5, 6, 5}, {2, 3, 2, 3, 2}, {2, 2, 1, 2, 1},
+        {1, 1, 1, 2, 1}, {1, 1, 1, 1, 1}, {-1, -1, -1, -1, -1}, {-1, -1, -1, -1, -2},
+        {-2, -2, -1, -1, -2}, {-2, -3, -2, -2, -3}, {-6, -6, -5, -5, -6}};
+    for (int i = 0; i < 10; ++i)
+    {
+        std::string text = std::string(values[i]) + std::string(padding, '0');
+        for (int mode = 0; mode < 5; ++mode)
+        {
+            std::stringstream stream(text);
+            Decimal number;
+            stream >> number;
+            std::stringstream printed;
+            printed << number;
+            number.Rounding() = modes[mode];
+            number.Rescale(0);
+            if (printed.str() != text ||
+                Integer::Compare(number.Unscaled(), Integer(expected[i][mode])) != 0)
+            {
+                out << "Test failed: rounding of " << text << " in mode " << mode
+                    << " gives " << number << '\n';
+                return false;
+            }
+        }
+    }
+
+    Decimal third(Rational(1, 3), padding + 1);
+    Decimal three(Integer(3), 0);
+    Decimal product(Integer(0), padding + 1, RoundingMode::Upward);
+    Decimal::Multiply(third, three, product);
+    Decimal quotient(Integer(0), padding + 1);
+    Decimal::Divide(Decimal(Integer(1), 0), three, quotient);
+    if (Decimal::Compare(product, Decimal(Integer(1), 0)) >= 0 ||
+        Decimal::Compare(third, quotient) != 0)
+    {
+        out << "Test failed: 3 * " << third << " = " << product << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunNativeTest(std::ostream& out, int n)
+{
+    // This test checks that operations with native integers agree with
+    // operations with long integers and rationals
+    const long long values[] = {0, 1, -1, n, -n, 99999999, 100000000, -123456789012345LL,
+        std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max()};
+    Integer number;
+    Integer::Subtract(Integer(n), Factorial(n), number);
+    Rational rational(number, Factorial(n / 2 + 1));
+    for (long long value : values)
+    {
+        Integer integer(value);
+        Integer nativeResult, longResult;
+        Rational nativeRational, longRational;
+        bool valid = Integer::Compare(number, value) == Integer::Compare(number, integer) &&
+            Integer::Compare(integer, value) == 0 &&
+            Rational::Compare(rational, value) == Rational::Compare(rational, Rational(integer));
+
+        Integer::Add(number, value, nativeResult);
+        Integer::Add(number, integer, longResult);
+        valid &= Integer::Compare(nativeResult, longResult) == 0;
+        Integer::Subtract(number, value, nativeResult);
+        Integer::Subtract(number, integer, longResult);
+        valid &= Integer::Compare(nativeResult, longResult) == 0;
+        Integer::Multiply(number, value, nativeResult);
+        Integer::Multiply(number, integer, longResult);
+        valid &= Integer::Compare(nativeResult, longResult) == 0;
+        // Products of both signs are added to and subtracted from integer
+        Integer::Add(longResult, integer, longResult);
+        nativeResult = integer;
+        Integer::AddMul(number, value, nativeResult);
+        valid &= Integer::Compare(nativeResult, longResult) == 0;
+        Integer::SubMul(number, value, nativeResult);
+        valid &= Integer::Compare(nativeResult, integer) == 0;
+
+        valid &= Rational::Compare(Rational(integer), value) == 0;
+        nativeRational = rational;
+        Rational::Add(nativeRational, value, nativeRational);
+        Rational::Subtract(nativeRational, value, nativeRational);
+        valid &= Rational::Compare(nativeRational, rational) == 0;
+        Rational::Add(rational, value, nativeRational);
+        Rational::Add(rational, Rational(integer), longRational);
+        valid &= Rational::Compare(nativeRational, longRational) == 0;
+        Rational::Subtract(rational, value, nativeRational);
+        Rational::Subtract(rational, Rational(integer), longRational);
+        valid &= Rational::Compare(nativeRational, longRational) == 0;
+        Rational::Multiply(rational, value, nativeRational);
+        Rational::Multiply(rational, Rational(integer), longRational);
+        valid &= Rational::Compare(nativeRational, longRational) == 0;
+        if (value != 0)
+        {
+            Integer::Divide(number, value, nativeResult);
+            Integer::Divide(number, integer, longResult);
+            valid &= Integer::Compare(nativeResult, longResult) == 0;
+            Integer::Mod(number, value, nativeResult);
+            Integer::Mod(number, integer, longResult);
+            valid &= Integer::Compare(nativeResult, longResult) == 0;
+            Rational::Divide(rational, value, nativeRational);
+            Rational::Divide(rational, Rational(integer), longRational);
+            valid &= Rational::Compare(nativeRational, longRational) == 0;
+            // Quotient of rationals is reduced
+            Rational::Divide(rational, Rational(Integer(value), Factorial(n)), longRational);
+            Rational reduced(longRational.Numerator(), longRational.Denominator());
+            valid &= Integer::Compare(longRational.Denominator(), reduced.Denominator()) == 0;
+        }
+        if (!valid)
+        {
+            out << "Test failed: operations of " << number << " and " << value << '\n';
+            return false;
+        }
+    }
+    unsigned long long maximum = std::numeric_limits<unsigned long long>::max();
+    Integer square, sum;
+    Integer::Multiply(Integer(1), maximum, square);
+    Integer::Multiply(square, maximum, square);
+    Integer::Add(square, maximum, sum);
+    Integer::Add(sum, 1, sum);
+    Integer::Divide(sum, maximum, sum);
+    Integer::Subtract(sum, maximum, sum);
+    if (Integer::Compare(sum, 1) != 0)
+    {
+        out << "Test failed: (m * m + m + 1) / m != m + 1 for m = " << maximum << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunDivModTest(std::ostream& out, int n)
+{
+    // This test checks number = quotient * divisor + surplus and bounds of surplus
+    // for every rounding of quotient
+    const RoundingMode modes[] = {RoundingMode::ToNearest, RoundingMode::ToNearestAway,
+        RoundingMode::TowardZero, RoundingMode::Upward, RoundingMode::Downward};
+    Integer numbers[4], divisors[4];
+    numbers[0] = Factorial(n + 2);
+    Integer::Add(Factorial(n + 3), n, numbers[1]);
+    Integer::Multiply(numbers[1], -1, numbers[2]);
+    numbers[3] = Integer(-n);
+    divisors[0] = Integer(n + 1);
+    Integer::Add(Factorial(n), 1, divisors[1]);
+    Integer::Multiply(divisors[1], -1, divisors[2]);
+    divisors[3] = Integer(-2);
+    for (const Integer& number : numbers)
+    {
+        for (const Integer& divisor : divisors)
+        {
+            Integer quotient, surplus, truncated, remainder;
+            Integer::Divide(number, divisor, truncated);
+            Integer::Mod(number, divisor, remainder);
+            for (int mode = 0; mode < 5; ++mode)
+            {
+                Integer::DivMod(number, divisor, quotient, surplus, modes[mode]);
+                Integer product, check, doubledSurplus;
+                Integer::Multiply(quotient, divisor, product);
+                Integer::Add(product, surplus, check);
+                Integer::Add(surplus, surplus, doubledSurplus);
+                int surplusSign = surplus.IsZero() ? 0 : surplus.Sign();
+                bool valid = Integer::Compare(check, number) == 0;
+                switch (modes[mode])
+                {
+                case RoundingMode::ToNearest:
+                case RoundingMode::ToNearestAway:
+                    valid &= Integer::Compare(Integer::AbsoluteValue(doubledSurplus),
+                        Integer::AbsoluteValue(divisor)) <= 0;
+                    break;
+                case RoundingMode::TowardZero:
+                    valid &= surplusSign != -number.Sign() &&
+                        Integer::Compare(quotient, truncated) == 0 &&
+                        Integer::Compare(surplus, remainder) == 0;
+                    break;
+                case RoundingMode::Upward:
+                    valid &= surplusSign != divisor.Sign();
+                    break;
+                case RoundingMode::Downward:
+                    valid &= surplusSign != -divisor.Sign();
+                    break;
+                }
+                valid &= Integer::Compare(Integer::AbsoluteValue(surplus),
+                    Integer::AbsoluteValue(divisor)) < 0;
+                if (!valid)
+                {
+                    out << "Test failed: " << number << " = " << quotient << " * "
+                        << divisor << " + " << surplus << " in mode " << mode << '\n';
+                    return false;
+                }
+            }
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunExactDivisionTest(std::ostream& out, int n)
+{
+    // This test checks that exact quotient of product restores its factor
+    // for divisors with trailing zero digits and factors shared with Base
+    Integer factors[3], divisors[5];
+    Integer::Add(Factorial(n + 1), n, factors[0]);
+    Integer::Multiply(Factorial(n), -3, factors[1]);
+    factors[2] = Integer(n);
+    Integer::Add(Factorial(n), 1, divisors[0]);
+    divisors[1] = Factorial(n + 2);
+    Integer::Power(Integer(2), 10 * n, divisors[2]);
+    Integer::Power(Integer(-5), 3 * n, divisors[3]);
+    Integer::Multiply(Factorial(n), 7, divisors[4]);
+    for (const Integer& factor : factors)
+    {
+        for (const Integer& divisor : divisors)
+        {
+            Integer product, quotient;
+            Integer::Multiply(factor, divisor, product);
+            Integer::DivideExact(product, divisor, quotient);
+            if (Integer::Compare(quotient, factor) != 0)
+            {
+                out << "Test failed: " << product << " / " << divisor
+                    << " = " << quotient << '\n';
+                return false;
+            }
+        }
+    }
+    Rational fraction(Factorial(n + 3), Factorial(n + 1));
+    Integer expected;
+    Integer::Multiply(Integer(n + 2), n + 3, expected);
+    if (Integer::Compare(fraction.Numerator(), expected) != 0 ||
+        Integer::Compare(fraction.Denominator(), Integer(1)) != 0)
+    {
+        out << "Test failed: " << fraction << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunConcurrencyTest(std::ostream& out, int n)
+{
+    // This test checks that concurrent divisions by shared read-only operands
+    // give the same results as sequential ones
+    LongArithmetic::ThreadPool pool(4);
+    Integer modulus;
+    Integer::Add(Factorial(n + 1), 1, modulus);
+    SharedInteger sharedModulus(1);
+    for (int i = 2; i <= n + 2; ++i)
+    {
+        SharedInteger::Multiply(sharedModulus, i, sharedModulus);
+    }
+    Rational fraction(modulus, Factorial(n));
+    const std::size_t tasks = 64;
+    std::vector<char> valid(tasks, 0);
+    pool.ParallelFor(tasks, [&](std::size_t i)
+    {
+        Integer number, quotient, surplus, check;
+        Integer::Multiply(Factorial(n + 3), static_cast<int>(i + 1), number);
+        Integer::Divide(number, modulus, quotient);
+        Integer::Mod(number, modulus, surplus);
+        Integer::Multiply(quotient, modulus, check);
+        Integer::Add(check, surplus, check);
+        bool passed = Integer::Compare(check, number) == 0 &&
+            Integer::Compare(surplus, modulus) < 0;
+
+        SharedInteger sharedNumber(sharedModulus), sharedQuotient, sharedSurplus, expected;
+        SharedInteger::Multiply(SharedInteger(n + 3), n + 4, expected);
+        SharedInteger::Multiply(sharedNumber, expected, sharedNumber);
+        SharedInteger::DivMod(sharedNumber, sharedModulus, sharedQuotient, sharedSurplus);
+        passed &= SharedInteger::Compare(sharedQuotient, expected) == 0 &&
+            sharedSurplus.IsZero();
+
+        Rational half(1, 2);
+        passed &= Rational::Compare(fraction, half) > 0 &&
+            Integer::Compare(fraction.Denominator(), Factorial(n)) == 0;
+        valid[i] = passed;
+    });
+    for (std::size_t i = 0; i < tasks; ++i)
+    {
+        if (!valid[i])
+        {
+            out << "Test failed: concurrent division by " << modulus
+                << " in task " << i << '\n';
+            return false;
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunPreparedDivisorTest(std::ostream& out, int n)
+{
+    // This test checks that division by prepared divisor agrees with long division
+    Integer divisors[5], numbers[4];
+    Integer::Add(Factorial(n), 1, divisors[0]);
+    Integer::Multiply(Factorial(n + 1), -1, divisors[1]);
+    divisors[2] = Integer(n + 6);
+    Integer::Power(Integer(10), 8 * (n % 4 + 1), divisors[3]);
+    Integer::Subtract(divisors[3], 1, divisors[4]);
+    Integer::Add(Factorial(3 * n), n, numbers[0]);
+    Integer::Multiply(Factorial(2 * n + 1), -7, numbers[1]);
+    numbers[2] = Integer(n);
+    numbers[3] = divisors[4];
+    for (const Integer& divisor : divisors)
+    {
+        PreparedDivisor prepared(divisor);
+        for (const Integer& number : numbers)
+        {
+            Integer quotient, surplus, expectedQuotient, expectedSurplus;
+            Integer::Divide(number, prepared, quotient);
+            Integer::Mod(number, prepared, surplus);
+            Integer::Divide(number, divisor, expectedQuotient);
+            Integer::Mod(number, divisor, expectedSurplus);
+            Integer inPlace(number);
+            Integer::Divide(inPlace, prepared, inPlace);
+            if (Integer::Compare(quotient, expectedQuotient) != 0 ||
+                Integer::Compare(surplus, expectedSurplus) != 0 ||
+                Integer::Compare(inPlace, expectedQuotient) != 0)
+            {
+                out << "Test failed: " << number << " = " << quotient << " * "
+                    << divisor << " + " << surplus << '\n';
+                return false;
+            }
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+Integer DigitwiseProduct(const Integer& number, const Integer& multiplier)
+{
+    Integer product(0);
+    for (unsigned int i = 0; i < multiplier.Length(); ++i)
+    {
+        Integer term, shifted;
+        Integer::SmallMultiply(number, multiplier.GetDigit(i), term);
+        Integer::ShiftLeft(term, i, shifted);
+        Integer::Add(product, shifted, product);
+    }
+    if (multiplier.Sign() < 0)
+    {
+        Integer::Multiply(product, -1, product);
+    }
+    return product;
+}
+
+bool RunPreparedMultiplierTest(std::ostream& out, int n)
+{
+    // This test checks products by prepared multiplier and long products,
+    // which are computed by transform, against products computed digit by digit
+    Integer multiplier;
+    Integer::Subtract(Integer(1), Factorial(25 * n), multiplier);
+    PreparedMultiplier prepared(multiplier);
+    const std::size_t tasks = 8;
+    std::vector<char> valid(tasks, 0);
+    LongArithmetic::ThreadPool pool(4);
+    pool.ParallelFor(tasks, [&](std::size_t i)
+    {
+        Integer number, product, preparedProduct, square;
+        Integer::Add(Factorial(static_cast<int>(30 * n + 10 * i)), n, number);
+        Integer::Multiply(number, multiplier, product);
+        Integer::Multiply(number, prepared, preparedProduct);
+        Integer::Multiply(number, number, square);
+        Integer expected = DigitwiseProduct(number, multiplier);
+        valid[i] = Integer::Compare(product, expected) == 0 &&
+            Integer::Compare(preparedProduct, expected) == 0 &&
+            Integer::Compare(square, DigitwiseProduct(number, number)) == 0;
+    });
+    for (std::size_t i = 0; i < tasks; ++i)
+    {
+        if (!valid[i])
+        {
+            out << "Test failed: product by " << multiplier << " in task " << i << '\n';
+            return false;
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunAccumulatorTest(std::ostream& out, int n)
+{
+    // This test checks accumulated sum of terms and products against sum
+    // computed by additions
+    Accumulator accumulator;
+    Integer expected(0);
+    for (int k = 0; k <= n; ++k)
+    {
+        Integer term, product, left, right;
+        Integer::Multiply(Binomial(n, k), k % 2 ? -1 : 1, term);
+        Integer::Add(Factorial(k), -k, left);
+        Integer::Subtract(Factorial(n - k), 1, right);
+        Integer::Multiply(left, right, product);
+        accumulator.Add(term);
+        accumulator.SubtractProduct(left, right);
+        accumulator.AddProduct(right, right);
+        accumulator.Subtract(Integer(-k));
+        Integer::Add(expected, term, expected);
+        Integer::Subtract(expected, product, expected);
+        Integer::Multiply(right, right, product);
+        Integer::Add(expected, product, expected);
+        Integer::Add(expected, k, expected);
+    }
+    Integer large;
+    Integer::Add(Factorial(30 * n), n, large);
+    accumulator.SubtractProduct(large, large);
+    Integer::Multiply(large, large, large);
+    Integer::Subtract(expected, large, expected);
+    if (Integer::Compare(accumulator.Value(), expected) != 0)
+    {
+        out << "Test failed: accumulated " << accumulator.Value() << " instead of "
+            << expected << '\n';
+        return false;
+    }
+    accumulator.Clear();
+    if (!accumulator.Value().IsZero())
+    {
+        out << "Test failed: cleared accumulator is not zero\n";
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunAddMulTest(std::ostream& out, int n)
+{
+    // This test checks fused r += a * b and r -= a * b against separate
+    // multiplication and addition, including results aliased with factors
+    Integer values[6];
+    Integer::Add(Factorial(n), 3, values[0]);
+    Integer::Multiply(Factorial(2 * n), -1, values[1]);
+    values[2] = Integer(0);
+    values[3] = Integer(-n);
+    Integer::Subtract(Integer(1), Factorial(4 * n), values[4]);
+    Integer::Add(Factorial(30 * n), n, values[5]);
+    for (const Integer& number : values)
+    {
+        for (const Integer& multiplier : values)
+        {
+            Integer product;
+            Integer::Multiply(number, multiplier, product);
+            for (const Integer& initial : values)
+            {
+                Integer sum(initial), difference(initial), expectedSum, expectedDifference;
+                Integer::AddMul(number, multiplier, sum);
+                Integer::SubMul(number, multiplier, difference);
+                Integer::Add(initial, product, expectedSum);
+                Integer::Subtract(initial, product, expectedDifference);
+                if (Integer::Compare(sum, expectedSum) != 0 ||
+                    Integer::Compare(difference, expectedDifference) != 0)
+                {
+                    out << "Test failed: " << initial << " +- " << number << " * "
+                        << multiplier << '\n';
+                    return false;
+                }
+            }
+            // Results of the length of the product change sign in place
+            Integer half, halfDifference, expectedHalf;
+            Integer::Divide(product, 2, half);
+            halfDifference = half;
+            Integer::SubMul(number, multiplier, halfDifference);
+            Integer::Subtract(half, product, expectedHalf);
+            for (int delta : { -1, 1 })
+            {
+                Integer close;
+                Integer::Add(product, delta, close);
+                Integer::SubMul(number, multiplier, close);
+                if (Integer::Compare(close, delta) != 0 ||
+                    Integer::Compare(halfDifference, expectedHalf) != 0)
+                {
+                    out << "Test failed: " << half << " or " << product << " + " << delta
+                        << " - " << number << " * " << multiplier << '\n';
+                    return false;
+                }
+            }
+
+            Integer aliased(number), expected;
+            Integer::AddMul(aliased, multiplier, aliased);
+            Integer::Add(number, product, expected);
+            if (Integer::Compare(aliased, expected) != 0)
+            {
+                out << "Test failed: " << number << " += " << number << " * "
+                    << multiplier << '\n';
+                return false;
+            }
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunRationalCompareTest(std::ostream& out, int n)
+{
+    // This test checks comparison of rationals, which are close, equal, far apart
+    // or of different signs, against comparison of cross products
+    std::vector<Rational> rationals;
+    Integer big, bigger;
+    Integer::Add(Factorial(2 * n), 1, big);
+    Integer::Add(big, 1, bigger);
+    rationals.push_back(Rational(big, Factorial(n)));
+    rationals.push_back(Rational(bigger, Factorial(n)));
+    rationals.push_back(Rational(Factorial(2 * n), Factorial(n)));
+    rationals.push_back(Rational(Factorial(n), big));
+    rationals.push_back(Rational(Factorial(n), bigger));
+    rationals.push_back(Rational(-n, n + 1));
+    rationals.push_back(Rational(-n - 1, n + 2));
+    rationals.push_back(Rational(0));
+    rationals.push_back(Rational(n, n + 1));
+    Integer scaled;
+    Integer::Multiply(big, n + 1, scaled);
+    rationals.push_back(Rational(scaled, Factorial(n + 1)));
+    Integer negative;
+    Integer::Multiply(bigger, -1, negative);
+    rationals.push_back(Rational(negative, Factorial(n)));
+    for (const Rational& lhs : rationals)
+    {
+        for (const Rational& rhs : rationals)
+        {
+            Integer left, right;
+            Integer::Multiply(lhs.Numerator(), rhs.Denominator(), left);
+            Integer::Multiply(rhs.Numerator(), lhs.Denominator(), right);
+            if (Rational::Compare(lhs, rhs) != Integer::Compare(left, right))
+            {
+                out << "Test failed: comparison of " << lhs << " and " << rhs << '\n';
+                return false;
+            }
+        }
+    }
+    std::sort(rationals.begin(), rationals.end(), [](const Rational& lhs, const Rational& rhs)
+    {
+        return Rational::Compare(lhs, rhs) < 0;
+    });
+    for (std::size_t i = 1; i < rationals.size(); ++i)
+    {
+        Rational difference;
+        Rational::Subtract(rationals[i], rationals[i - 1], difference);
+        if (difference.Numerator().Sign() < 0)
+        {
+            out << "Test failed: " << rationals[i - 1] << " and " << rationals[i]
+                << " are not sorted\n";
+            return false;
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunExpressionTest(std::ostream& out, int n)
+{
+    // This test checks operators against static functions, including
+    // compound and self-referencing assignments
+    Integer a, b(-n - 2), c(n + 3), d;
+    Integer::Add(Factorial(n), 1, a);
+    Integer::Subtract(Integer(1), Factorial(2 * n), d);
+
+    Integer ab, cd, expected;
+    Integer::Multiply(a, b, ab);
+    Integer::Multiply(c, d, cd);
+    Integer::Add(ab, cd, expected);
+    Integer sum = a * b + c * d;
+    Integer difference;
+    difference = a * b - c * d;
+    bool valid = Integer::Compare(sum, expected) == 0;
+    Integer::Subtract(ab, cd, expected);
+    valid &= Integer::Compare(difference, expected) == 0;
+
+    Integer mixed = (a + b) * (c - d) / b % c;
+    Integer left, right;
+    Integer::Add(a, b, left);
+    Integer::Subtract(c, d, right);
+    Integer::Multiply(left, right, expected);
+    Integer::Divide(expected, b, expected);
+    Integer::Mod(expected, c, expected);
+    valid &= Integer::Compare(mixed, expected) == 0;
+
+    Integer self(a);
+    self = self * self + self;
+    Integer::Multiply(a, a, expected);
+    Integer::Add(expected, a, expected);
+    valid &= Integer::Compare(self, expected) == 0;
+
+    Integer compound(d);
+    compound += a * b;
+    compound -= compound * c;
+    compound *= compound;
+    compound /= a;
+    compound %= d;
+    Integer::Add(d, ab, expected);
+    Integer product;
+    Integer::Multiply(expected, c, product);
+    Integer::Subtract(expected, product, expected);
+    Integer::Multiply(expected, expected, expected);
+    Integer::Divide(expected, a, expected);
+    Integer::Mod(expected, d, expected);
+    valid &= Integer::Compare(compound, expected) == 0;
+
+    Rational p(a, c), q(b, d);
+    Rational rational = p * p + p / q;
+    rational -= q;
+    rational *= rational;
+    Rational square, quotient, expectedRational;
+    Rational::Multiply(p, p, square);
+    Rational::Divide(p, q, quotient);
+    Rational::Add(square, quotient, expectedRational);
+    Rational::Subtract(expectedRational, q, expectedRational);
+    Rational::Multiply(expectedRational, expectedRational, expectedRational);
+    valid &= Rational::Compare(rational, expectedRational) == 0;
+    if (!valid)
+    {
+        out << "Test failed: expressions of " << a << ", " << b << ", " << c
+            << ", " << d << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+LongArithmetic::Number DigitsOf(const Integer& integer)
+{
+    LongArithmetic::Number number(0, integer.Length());
+    for (unsigned int i = 0; i < integer.Length(); ++i)
+    {
+        number.GetDigit(i) = integer.GetDigit(i);
+    }
+    number.Length() = integer.Length();
+    return number;
+}
+
+bool RunThresholdTest(std::ostream& out, int n)
+{
+    // This test checks override of thresholds by environment variables
+    // and agreement of multiplication algorithms chosen by thresholds
+    using Number = LongArithmetic::Number;
+    const char* name = "LONG_ARITHMETIC_TESTER_THRESHOLD";
+    std::string value = std::to_string(n);
+    setenv(name, value.c_str(), 1);
+    bool overridden = LongArithmetic::TunedThreshold(name, 7) == static_cast<unsigned int>(n);
+    setenv(name, "12x", 1);
+    bool malformed = LongArithmetic::TunedThreshold(name, 7) == 7;
+    unsetenv(name);
+    bool missing = LongArithmetic::TunedThreshold(name, 7) == 7;
+    if (!overridden || !malformed || !missing)
+    {
+        out << "Test failed: threshold given by " << name << '\n';
+        return false;
+    }
+
+    Number number = DigitsOf(Factorial(40 * n));
+    Number multiplier = DigitsOf(Factorial(30 * n + 7));
+    Number product(0, number.Length() + multiplier.Length() + 1);
+    Number expected(0, number.Length() + multiplier.Length() + 1);
+    Number square(0, 2 * number.Length() + 1);
+    Number expectedSquare(0, 2 * number.Length() + 1);
+    Number::TransformMultiply(number, multiplier, product);
+    Number::SchoolbookMultiply(number, multiplier, expected);
+    Number::TransformMultiply(number, number, square);
+    Number::SchoolbookMultiply(number, number, expectedSquare);
+    if (Number::Compare(product, expected) != 0 ||
+        Number::Compare(square, expectedSquare) != 0)
+    {
+        out << "Test failed: products of " << number << " and " << multiplier << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunSeriesTest(std::ostream& out, int n)
+{
+    // This test checks binary splitting of geometric series
+    // sum_{k=0}^{m-1} 1 / 2^k = (2^m - 1) / 2^(m-1) and digits of pi and e
+    LongArithmetic::ThreadPool pool(3);
+    unsigned int terms = static_cast<unsigned int>(10 * n);
+    Integer p, q, t;
+    Series::Split([](unsigned int k, Integer& p, Integer& q, Integer& a)
+        {
+            p = Integer(1);
+            q = Integer(k == 0 ? 1 : 2);
+            a = Integer(1);
+        }, 0, terms, p, q, t, true, pool);
+    Integer power, numerator, denominator;
+    Integer::Power(Integer(2), terms - 1, denominator);
+    Integer::Add(denominator, denominator, power);
+    Integer::Subtract(power, Integer(1), numerator);
+    if (Integer::Compare(p, Integer(1)) != 0 || Integer::Compare(q, denominator) != 0 ||
+        Integer::Compare(t, numerator) != 0)
+    {
+        out << "Test failed: geometric series of " << terms << " terms\n";
+        return false;
+    }
+
+    const std::string piDigits = "3.14159265358979323846264338327950288419716939937510"
+        "58209749445923078164062862089986280348253421170679"
+        "82148086513282306647093844609550582231725359408128"
+        "48111745028410270193852110555964462294895493038196";
+    const std::string eDigits = "2.71828182845904523536028747135266249775724709369995"
+        "95749669676277240766303535475945713821785251664274"
+        "27466391932003059921817413596629043572900334295260"
+        "59563073813232862794349076323382988075319525101901";
+    unsigned int digits = static_cast<unsigned int>(n + 50);
+    Decimal pi, e;
+    std::istringstream(piDigits) >> pi;
+    std::istringstream(eDigits) >> e;
+    pi.Rescale(digits);
+    e.Rescale(digits);
+    Decimal computedPi = Series::Pi(digits, pool);
+    Decimal computedE = Series::E(digits, pool);
+    if (Decimal::Compare(computedPi, pi) != 0 || Decimal::Compare(computedE, e) != 0)
+    {
+        out << "Test failed: " << digits << " digits of pi = " << computedPi
+            << ", e = " << computedE << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunMatrixTest(std::ostream& out, int n)
+{
+    // This test checks determinants of Vandermonde matrices
+    // det(x_i^j) = prod_{i < j} (x_j - x_i) and solutions of linear systems with them
+    LongArithmetic::ThreadPool pool(3);
+    unsigned int size = 2 + n / 12;
+    std::vector<Integer> points(size);
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        Integer::Multiply(Factorial(n / 4 + 1), static_cast<long long>(i * i + 1), points[i]);
+        Integer::Add(points[i], Integer(i), points[i]);
+    }
+    Matrix vandermonde(size, size);
+    Integer expected(1);
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        Integer::Power(points[i], size - 1, vandermonde.GetEntry(size - 1 - i, 0));
+        for (unsigned int j = 1; j < size; ++j)
+        {
+            Integer::Power(points[i], j - 1, vandermonde.GetEntry(size - 1 - i, j));
+        }
+        for (unsigned int j = i + 1; j < size; ++j)
+        {
+            Integer difference;
+            Integer::Subtract(points[j], points[i], difference);
+            Integer::Multiply(expected, difference, expected);
+        }
+    }
+    // Rows are reversed and the last column is moved to the front
+    if (((size / 2) + (size - 1)) % 2 != 0)
+    {
+        Integer::Multiply(expected, -1, expected);
+    }
+    Integer determinant = Matrix::Determinant(vandermonde, pool);
+    Integer modularDeterminant = Matrix::ModularDeterminant(vandermonde, pool);
+    if (Integer::Compare(determinant, expected) != 0 ||
+        Integer::Compare(modularDeterminant, expected) != 0)
+    {
+        out << "Test failed: determinant of Vandermonde matrix of size " << size
+            << " is " << determinant << ", " << modularDeterminant << " != " << expected << '\n';
+        return false;
+    }
+
+    std::vector<Integer> rhs(size);
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        rhs[i] = Integer(static_cast<long long>(i * n) - 7);
+    }
+    std::vector<Rational> solution = Matrix::Solve(vandermonde, rhs, pool);
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        Rational sum(Integer(0), Integer(1));
+        for (unsigned int j = 0; j < size; ++j)
+        {
+            Rational product;
+            Rational::Multiply(Rational(vandermonde.GetEntry(i, j), Integer(1)), solution[j], product);
+            Rational::Add(sum, product, sum);
+        }
+        if (Rational::Compare(sum, Rational(rhs[i], Integer(1))) != 0)
+        {
+            out << "Test failed: solution of system with Vandermonde matrix of size "
+                << size << " in row " << i << '\n';
+            return false;
+        }
+    }
+
+    Matrix singular(vandermonde);
+    for (unsigned int j = 0; j < size; ++j)
+    {
+        singular.GetEntry(size - 1, j) = singular.GetEntry(0, j);
+    }
+    bool thrown = false;
+    try
+    {
+        Matrix::Solve(singular, rhs, pool);
+    }
+    catch (const std::domain_error&)
+    {
+        thrown = true;
+    }
+    if (!Matrix::Determinant(singular, pool).IsZero() ||
+        !Matrix::ModularDeterminant(singular, pool).IsZero() || !thrown)
+    {
+        out << "Test failed: singular matrix of size " << size << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunResidueSystemTest(std::ostream& out, int n)
+{
+    // This test checks residues found by remainder tree against remainders
+    // of division and reconstruction of numbers from their residues
+    LongArithmetic::ThreadPool pool(3);
+    std::vector<unsigned long long> moduli;
+    for (unsigned long long candidate = 2147483647ULL; moduli.size() < 5u * n; candidate -= 2)
+    {
+        bool prime = true;
+        for (unsigned long long divisor = 3; divisor * divisor <= candidate && prime; divisor += 2)
+        {
+            prime = candidate % divisor != 0;
+        }
+        if (prime)
+        {
+            moduli.push_back(candidate);
+        }
+    }
+    ResidueSystem system(moduli, pool);
+
+    Integer number, large;
+    Integer::Subtract(Integer(n), Factorial(8 * n), number);
+    Integer::Multiply(Factorial(30 * n), Factorial(7 * n), large);
+    std::vector<unsigned long long> residues, largeResidues;
+    system.Reduce(number, residues, pool);
+    system.Reduce(large, largeResidues, pool);
+    for (std::size_t i = 0; i < moduli.size(); ++i)
+    {
+        unsigned long long remainder = Integer::SmallRemainder(number, moduli[i]);
+        if (remainder != 0)
+        {
+            remainder = moduli[i] - remainder;
+        }
+        if (residues[i] != remainder ||
+            largeResidues[i] != Integer::SmallRemainder(large, moduli[i]))
+        {
+            out << "Test failed: residue modulo " << moduli[i] << '\n';
+            return false;
+        }
+    }
+
+    Integer reconstructed, largeReconstructed, largeRemainder;
+    system.Reconstruct(residues, reconstructed, true, pool);
+    system.Reconstruct(largeResidues, largeReconstructed, false, pool);
+    Integer::Mod(large, system.Modulus(), largeRemainder);
+    if (Integer::Compare(reconstructed, number) != 0 ||
+        Integer::Compare(largeReconstructed, largeRemainder) != 0)
+    {
+        out << "Test failed: reconstruction of " << number << " from "
+            << moduli.size() << " residues gives " << reconstructed << '\n';
+        return false;
+    }
+
+    bool thrown = false;
+    try
+    {
+        ResidueSystem invalid(std::vector<unsigned long long>{ 6, 35, 10 }, pool);
+    }
+    catch (const std::domain_error&)
+    {
+        thrown = true;
+    }
+    if (!thrown)
+    {
+        out << "Test failed: moduli which are not coprime are accepted\n";
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+Rational LimitDenominator(const Rational& rational, const Integer& maxDenominator)
+{
+    // Reference implementation dividing full remainders at every step
+    Integer p0(0), q0(1), p1(1), q1(0), n(rational.Numerator()), d(rational.Denominator());
+    while (!d.IsZero())
+    {
+        Integer quotient, remainder, q2(q0);
+        Integer::DivMod(n, d, quotient, remainder, LongArithmetic::RoundingMode::Downward);
+        Integer::AddMul(quotient, q1, q2);
+        if (Integer::Compare(q2, maxDenominator) > 0)
+        {
+            break;
+        }
+        Integer::AddMul(quotient, p1, p0);
+        p0.Swap(p1);
+        q0.Swap(q1);
+        q1.Swap(q2);
+        n.Swap(d);
+        d.Swap(remainder);
+    }
+    if (d.IsZero())
+    {
+        return rational;
+    }
+    Integer k, p, q;
+    Integer::Subtract(maxDenominator, q0, k);
+    Integer::Divide(k, q1, k);
+    Integer::Multiply(k, p1, p);
+    Integer::Add(p, p0, p);
+    Integer::Multiply(k, q1, q);
+    Integer::Add(q, q0, q);
+    Rational semiconvergent(p, q), convergent(p1, q1), error, lastError;
+    Rational::Subtract(semiconvergent, rational, error);
+    Rational::Subtract(convergent, rational, lastError);
+    error.Sign() = 1;
+    lastError.Sign() = 1;
+    return Rational::Compare(lastError, error) <= 0 ? convergent : semiconvergent;
+}
+
+bool RunContinuedFractionTest(std::ostream& out, int n)
+{
+    // This test checks expansion of rationals into continued fractions
+    // and approximations of rationals with bounded denominators
+    Integer numerator, denominator;
+    Integer::Add(Factorial(3 * n), Integer(n), numerator);
+    Integer::Subtract(Integer(1), Factorial(2 * n + 1), denominator);
+    Rational rational(numerator, denominator);
+    ContinuedFraction fraction(rational);
+    std::vector<Integer> quotients;
+    while (!fraction.Done())
+    {
+        Integer quotient;
+        fraction.Next(quotient);
+        if (!quotients.empty() && quotient.Sign() <= 0)
+        {
+            out << "Test failed: partial quotient " << quotient << " of " << rational << '\n';
+            return false;
+        }
+        quotients.push_back(quotient);
+    }
+    Rational value(quotients.back());
+    for (std::size_t i = quotients.size() - 1; i-- > 0;)
+    {
+        Rational inverse(value.Denominator(), value.Numerator());
+        Rational::Add(inverse, Rational(quotients[i]), value);
+    }
+    if (Rational::Compare(value, rational) != 0 || Rational::Compare(fraction.Convergent(), rational) != 0)
+    {
+        out << "Test failed: continued fraction of " << rational << " gives " << value << '\n';
+        return false;
+    }
+
+    // pi to many digits is approximated by famous fractions
+    Decimal pi = LongArithmetic::Series::Pi(20 + n);
+    Integer scale(1);
+    for (int i = 0; i < 20 + n; ++i)
+    {
+        Integer::Multiply(scale, Integer(10), scale);
+    }
+    Rational piRational(pi.Unscaled(), scale), approximation;
+    Rational::LimitDenominator(piRational, Integer(1000), approximation);
+    if (Rational::Compare(approximation, Rational(355, 113)) != 0)
+    {
+        out << "Test failed: approximation of pi is " << approximation << '\n';
+        return false;
+    }
+
+    // Long rationals are compared with reference implementation
+    Integer longNumerator, longDenominator, maxDenominator;
+    Integer::Subtract(Factorial(20 * n), Integer(7), longNumerator);
+    Integer::Add(Factorial(20 * n - 1), Factorial(10 * n), longDenominator);
+    Integer::Add(Factorial(5 * n), Integer(n), maxDenominator);
+    Rational longRational(longNumerator, longDenominator);
+    std::vector<Rational> values{ longRational, Rational(longDenominator, longNumerator), rational };
+    for (const Rational& source : values)
+    {
+        for (int sign = -1; sign <= 1; sign += 2)
+        {
+            Rational signedSource(source), expected, actual;
+            signedSource.Sign() *= sign;
+            expected = LimitDenominator(signedSource, maxDenominator);
+            Rational::LimitDenominator(signedSource, maxDenominator, actual);
+            if (Rational::Compare(expected, actual) != 0 ||
+                Integer::Compare(actual.Denominator(), maxDenominator) > 0)
+            {
+                out << "Test failed: approximation with denominator up to " << maxDenominator
+                    << " is " << actual << " instead of " << expected << '\n';
+                return false;
+            }
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunParserTest(std::ostream& out, int n)
+{
+    // This test checks parsing of numbers from buffers and files
+    Integer number, parsed;
+    Integer::Subtract(Integer(n), Factorial(50 * n), number);
+    std::ostringstream numberStream;
+    numberStream << "\n  " << number << " \t\n";
+    std::string text = numberStream.str();
+    Parser::Parse(text.data(), text.data() + text.size(), parsed);
+    if (Integer::Compare(parsed, number) != 0)
+    {
+        out << "Test failed: parsing of " << number << " gives " << parsed << '\n';
+        return false;
+    }
+
+    // Every position of a wrong character is rejected
+    std::ostringstream digitStream;
+    digitStream << Factorial(n + 20);
+    std::string digits = digitStream.str();
+    for (std::size_t i = 0; i < digits.size(); ++i)
+    {
+        for (char wrong : { '/', ':', '.', '\xFF' })
+        {
+            std::string malformed(digits);
+            malformed[i] = wrong;
+            bool thrown = false;
+            try
+            {
+                Parser::Parse(malformed.data(), malformed.data() + malformed.size(), parsed);
+            }
+            catch (const std::invalid_argument&)
+            {
+                thrown = true;
+            }
+            if (!thrown)
+            {
+                out << "Test failed: malformed integer " << malformed << " is accepted\n";
+                return false;
+            }
+        }
+    }
+
+    char path[] = "/tmp/long_parser_XXXXXX";
+    int descriptor = mkstemp(path);
+    if (descriptor < 0)
+    {
+        out << "Test failed: temporary file is not created\n";
+        return false;
+    }
+    close(descriptor);
+    Rational rational(number, Factorial(20 * n) + Integer(1)), parsedRational;
+    {
+        std::ofstream file(path);
+        file << rational << '\n';
+    }
+    Parser::ParseFile(path, parsedRational);
+    std::remove(path);
+    if (Rational::Compare(parsedRational, rational) != 0)
+    {
+        out << "Test failed: parsing of file with " << rational << " gives " << parsedRational << '\n';
+        return false;
+    }
+    bool thrown = false;
+    try
+    {
+        Parser::ParseFile(path, parsed);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    if (!thrown)
+    {
+        out << "Test failed: missing file is parsed\n";
+        return false;
+    }
+
+    // Lists are split between threads on line boundaries
+    LongArithmetic::ThreadPool pool(3);
+    std::vector<Integer> expected(40 * n), integers;
+    std::ostringstream listStream;
+    for (int i = 0; i < 40 * n; ++i)
+    {
+        Integer::Multiply(Factorial(n), Integer(i - 20 * n), expected[i]);
+        Integer::Add(expected[i], Integer(i), expected[i]);
+        listStream << expected[i] << (i % 3 == 2 ? "\r\n" : i % 3 == 1 ? ", " : ",");
+    }
+    std::string list = listStream.str();
+    Parser::ParseList(list.data(), list.data() + list.size(), integers, pool);
+    if (integers.size() != expected.size() ||
+        !std::equal(integers.begin(), integers.end(), expected.begin(),
+            [](const Integer& lhs, const Integer& rhs) { return Integer::Compare(lhs, rhs) == 0; }))
+    {
+        out << "Test failed: list of " << expected.size() << " integers gives "
+            << integers.size() << " integers\n";
+        return false;
+    }
+    std::vector<Rational> rationals;
+    std::string rationalList = "1/2\n-3/4, 5\n\n7/0\n";
+    std::string message;
+    try
+    {
+        Parser::ParseList(rationalList.data(), rationalList.data() + rationalList.size(),
+            rationals, pool);
+    }
+    catch (const std::invalid_argument& error)
+    {
+        message = error.what();
+    }
+    std::size_t line = 9 * n + 1;
+    std::string malformed = list;
+    std::size_t position = 0;
+    for (std::size_t i = 1; i < line; ++i)
+    {
+        position = malformed.find('\n', position) + 1;
+    }
+    malformed.insert(position, "12x4,");
+    std::string listMessage;
+    try
+    {
+        Parser::ParseList(malformed.data(), malformed.data() + malformed.size(), integers, pool);
+    }
+    catch (const std::invalid_argument& error)
+    {
+        listMessage = error.what();
+    }
+    if (message != "Malformed number at line 4" ||
+        listMessage != "Malformed number at line " + std::to_string(line))
+    {
+        out << "Test failed: errors of lists are reported as '" << message << "' and '"
+            << listMessage << "'\n";
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunPrimalityTest(std::ostream& out, int n)
+{
+    // This test checks Montgomery arithmetic against operations of integers,
+    // probable prime test on known primes and pseudoprimes and search of primes
+    LongArithmetic::ThreadPool pool(3);
+    Integer modulus, lhs, rhs;
+    Integer::Add(Factorial(n + 5), Integer(1), modulus);
+    Integer::Subtract(Factorial(n + 4), Integer(n), lhs);
+    Integer::Multiply(Factorial(n + 3), Integer(n + 1), rhs);
+    ModularContext context(modulus);
+    ModularContext::ResidueType left = context.Residue(), right = context.Residue();
+    ModularContext::ResidueType product = context.Residue(), sum = context.Residue();
+    ModularContext::ResidueType difference = context.Residue(), half = context.Residue();
+    context.ToResidue(lhs, left);
+    context.ToResidue(rhs, right);
+    context.Multiply(left, right, product);
+    context.Add(left, right, sum);
+    context.Subtract(right, left, difference);
+    context.Half(left, half);
+    Integer expected, actual;
+    Integer::Multiply(lhs, rhs, expected);
+    Integer::Mod(expected, modulus, expected);
+    context.FromResidue(product, actual);
+    bool correct = Integer::Compare(actual, expected) == 0;
+    Integer::Add(lhs, rhs, expected);
+    Integer::Mod(expected, modulus, expected);
+    context.FromResidue(sum, actual);
+    correct = correct && Integer::Compare(actual, expected) == 0;
+    Integer::Subtract(rhs, lhs, expected);
+    Integer::Add(expected, modulus, expected);
+    Integer::Mod(expected, modulus, expected);
+    context.FromResidue(difference, actual);
+    correct = correct && Integer::Compare(actual, expected) == 0;
+    context.FromResidue(half, actual);
+    Integer::Multiply(actual, Integer(2), actual);
+    Integer::Mod(actual, modulus, actual);
+    correct = correct && Integer::Compare(actual, lhs) == 0;
+    // Numbers longer than modulus and negative numbers are reduced
+    Integer wide;
+    Integer::Multiply(lhs, rhs, wide);
+    Integer::Multiply(wide, lhs, wide);
+    Integer::Subtract(Integer(n), wide, wide);
+    context.ToResidue(wide, left);
+    context.FromResidue(left, actual);
+    Integer::Mod(wide, modulus, expected);
+    Integer::Add(expected, modulus, expected);
+    Integer::Mod(expected, modulus, expected);
+    correct = correct && Integer::Compare(actual, expected) == 0;
+    if (!correct)
+    {
+        out << "Test failed: Montgomery arithmetic modulo " << modulus << '\n';
+        return false;
+    }
+
+    // Mersenne primes, Carmichael numbers, strong pseudoprime to bases up to 37,
+    // square of prime and product of primes
+    Integer mersenne89, mersenne127, square, semiprime;
+    Integer::Power(Integer(2), 89, mersenne89);
+    Integer::Subtract(mersenne89, Integer(1), mersenne89);
+    Integer::Power(Integer(2), 127, mersenne127);
+    Integer::Subtract(mersenne127, Integer(1), mersenne127);
+    Integer::Multiply(mersenne89, mersenne89, square);
+    Integer::Multiply(mersenne89, mersenne127, semiprime);
+    if (!Primality::IsProbablePrime(mersenne89) || !Primality::IsProbablePrime(mersenne127) ||
+        Primality::IsProbablePrime(Integer(561)) || Primality::IsProbablePrime(Integer(41041)) ||
+        Primality::IsProbablePrime(Integer(3825123056546413051LL)) ||
+        Primality::IsProbablePrime(square) || Primality::IsProbablePrime(semiprime))
+    {
+        out << "Test failed: probable prime test on known numbers\n";
+        return false;
+    }
+
+    // Small numbers are compared with trial division
+    for (long long number = 100 * n - 100; number < 100 * n; ++number)
+    {
+        bool prime = number > 1;
+        for (long long divisor = 2; divisor * divisor <= number && prime; ++divisor)
+        {
+            prime = number % divisor != 0;
+        }
+        if (Primality::IsProbablePrime(Integer(number)) != prime)
+        {
+            out << "Test failed: primality of " << number << '\n';
+            return false;
+        }
+    }
+
+    // Next prime after large number has no probable primes before it
+    Integer start(Factorial(n + 20)), next;
+    next = Primality::NextPrime(start, pool);
+    if (Integer::Compare(next, start) <= 0 || !Primality::IsProbablePrime(next))
+    {
+        out << "Test failed: next prime after " << start << " is " << next << '\n';
+        return false;
+    }
+    for (Integer::Add(start, Integer(1), start); Integer::Compare(start, next) < 0;
+        Integer::Add(start, Integer(1), start))
+    {
+        if (Primality::IsProbablePrime(start))
+        {
+            out << "Test failed: prime " << start << " is skipped by search\n";
+            return false;
+        }
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+bool RunDiskNumberTest(std::ostream& out, int n)
+{
+    // This test checks arithmetic of numbers stored in files
+    std::vector<std::string> paths;
+    auto temporary = [&paths]()
+    {
+        char path[] = "/tmp/long_disk_number_XXXXXX";
+        int descriptor = mkstemp(path);
+        if (descriptor >= 0)
+        {
+            close(descriptor);
+        }
+        paths.push_back(path);
+        return paths.back();
+    };
+    auto removeAll = [&paths]()
+    {
+        for (const std::string& path : paths)
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+    // Digits equal to Base - 1 give the largest values of transform
+    std::istringstream nines(std::string(8 * (3 * n + 5), '9'));
+    Integer lhs, rhs, expected, actual;
+    nines >> lhs;
+    Integer::Add(Factorial(25 * n), Integer(n), rhs);
+    LongArithmetic::ThreadPool pool(2);
+    // Short rows of transform make every pass span several rows and stripes
+    DiskNumber::SizeType blockLength = 4u << n % 5;
+    {
+        DiskNumber left(temporary(), lhs), right(temporary(), rhs);
+        DiskNumber product(temporary(), 2 * std::max(left.Length(), right.Length()));
+        DiskNumber::Multiply(left, right, product, blockLength, pool);
+        Integer::Multiply(lhs, rhs, expected);
+        product.ToInteger(actual);
+        if (Integer::Compare(actual, expected) != 0)
+        {
+            out << "Test failed: product of " << lhs << " and " << rhs << " stored in files is "
+                << actual << ", expected " << expected << '\n';
+            removeAll();
+            return false;
+        }
+        DiskNumber::Multiply(right, right, product, blockLength, pool);
+        Integer::Multiply(rhs, rhs, expected);
+        product.ToInteger(actual);
+        if (Integer::Compare(actual, expected) != 0)
+        {
+            out << "Test failed: square of " << rhs << " stored in file is "
+                << actual << ", expected " << expected << '\n';
+            removeAll();
+            return false;
+        }
+
+        DiskNumber sum(temporary(), std::max(left.Length(), right.Length()) + 2);
+        DiskNumber::Add(left, right, sum);
+        DiskNumber::Add(sum, left, sum);
+        Integer::Add(lhs, rhs, expected);
+        Integer::Add(expected, lhs, expected);
+        sum.ToInteger(actual);
+        if (Integer::Compare(actual, expected) != 0)
+        {
+            out << "Test failed: sum of " << lhs << ", " << rhs << " and " << lhs
+                << " stored in files is " << actual << ", expected " << expected << '\n';
+            removeAll();
+            return false;
+        }
+
+        bool thrown = false;
+        try
+        {
+            DiskNumber::Multiply(left, right, sum, blockLength, pool);
+        }
+        catch (const std::invalid_argument&)
+        {
+            thrown = true;
+        }
+        if (!thrown)
+        {
+            out << "Test failed: product is written into too short file\n";
+            removeAll();
+            return false;
+        }
+    }
+
+    // Digits are kept in files after numbers are destroyed
+    DiskNumber stored(paths[2]);
+    stored.ToInteger(actual);
+    Integer::Multiply(rhs, rhs, expected);
+    removeAll();
+    if (Integer::Compare(actual, expected) != 0)
+    {
+        out << "Test failed: stored square of " << rhs << " is read as " << actual << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
 int main() {
     for (int attempt = 0; attempt < 10; ++attempt)
     {
@@ -70,6 +1616,188 @@ int main() {
             return 1;
         }
     }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunRootTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunSharedTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunReductionTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunNativeTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunDivModTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunExactDivisionTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunConcurrencyTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunPreparedDivisorTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunPreparedMultiplierTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunAccumulatorTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunAddMulTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunRationalCompareTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunExpressionTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunThresholdTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunSeriesTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunMatrixTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunResidueSystemTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunPrimalityTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunContinuedFractionTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunParserTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        int n = (attempt + 1) * (attempt + 1);
+        if (!RunDiskNumberTest(std::cout, n))
+        {
+            return 1;
+        }
+    }
+    for (int padding = 0; padding < 20; ++padding)
+    {
+        if (!RunDecimalTest(std::cout, padding))
+        {
+            return 1;
+        }
+    }
+    for (unsigned int precision = 1; precision <= 10; ++precision)
+    {
+        if (!RunFloatTest(std::cout, precision))
+        {
+            return 1;
+        }
+    }
     return 0;
 }
 
@@ -0,0 +1,132 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include "long_arithmetic.h"
+
+// Measures crossovers of multiplication algorithms on the local machine
+// and writes header of thresholds, which is read by dispatch code.
+// Usage: tuner [output header], header is written to standard output by default
+
+using Number = LongArithmetic::Number;
+using SizeType = Number::SizeType;
+
+// Returns number of given length with random digits
+Number RandomNumber(std::mt19937& generator, SizeType length)
+{
+    std::uniform_int_distribution<Number::DigitType> digit(1, LongArithmetic::DEFAULT_NUMBER_BASE - 1);
+    Number number(0, length);
+    for (SizeType i = 0; i < length; ++i)
+    {
+        number.GetDigit(i) = static_cast<Number::StorageType>(digit(generator));
+    }
+    number.Length() = length;
+    return number;
+}
+
+// Returns the least time in seconds of product computation by multiply
+// over several runs, each of which lasts at least a few milliseconds
+template <typename Multiply>
+double MeasureProduct(Multiply multiply, const Number& number, const Number& multiplier)
+{
+    using Clock = std::chrono::steady_clock;
+    const double minimalRunTime = 0.005;
+    const int runCount = 5;
+    Number result(0, number.Length() + multiplier.Length() + 1);
+    double bestTime = 0.0;
+    for (int run = 0; run < runCount; ++run)
+    {
+        int repetitions = 0;
+        double time = 0.0;
+        Clock::time_point start = Clock::now();
+        do
+        {
+            multiply(number, multiplier, result);
+            ++repetitions;
+            time = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (time < minimalRunTime);
+        time /= repetitions;
+        if (run == 0 || time < bestTime)
+        {
+            bestTime = time;
+        }
+    }
+    return bestTime;
+}
+
+// Returns the least length from which transform beats schoolbook multiplication
+// at every measured length, or the largest length if transform is slower
+// at the longest measured length. Squares are measured if square is set
+SizeType FindMultiplyThreshold(std::mt19937& generator, bool square, std::ostream& log)
+{
+    const SizeType minimalLength = 8;
+    const SizeType maximalLength = 2048;
+    SizeType threshold = std::numeric_limits<SizeType>::max();
+    bool transformWins = true;
+    for (SizeType length = maximalLength; length >= minimalLength; length = length * 7 / 8)
+    {
+        if (!Number::TransformApplies(length, length))
+        {
+            continue;
+        }
+        Number number = RandomNumber(generator, length);
+        Number multiplier = RandomNumber(generator, length);
+        // Squares are detected by identity of factors
+        const Number& other = square ? number : multiplier;
+        double schoolbookTime = MeasureProduct(Number::SchoolbookMultiply, number, other);
+        double transformTime = MeasureProduct(Number::TransformMultiply, number, other);
+        log << (square ? "square  " : "multiply") << " length " << length
+            << ": schoolbook " << schoolbookTime * 1e6 << " us"
+            << ", transform " << transformTime * 1e6 << " us\n";
+        if (transformTime >= schoolbookTime)
+        {
+            transformWins = false;
+        }
+        if (transformWins)
+        {
+            threshold = length;
+        }
+    }
+    return threshold;
+}
+
+void WriteHeader(std::ostream& out, SizeType multiplyThreshold, SizeType squareThreshold)
+{
+    out << "#ifndef LONG_ARITHMETIC_LONG_THRESHOLDS_H_\n"
+        << "#define LONG_ARITHMETIC_LONG_THRESHOLDS_H_\n"
+        << "\n"
+        << "// Crossovers of multiplication algorithms.\n"
+        << "// Generated by `make tune` from measurements on the local machine\n"
+        << "namespace LongArithmetic\n"
+        << "{\n"
+        << "    // Length of shorter factor from which products are computed by transform\n"
+        << "    const unsigned int TRANSFORM_MULTIPLY_THRESHOLD = " << multiplyThreshold << ";\n"
+        << "    // Length of number from which squares are computed by transform\n"
+        << "    const unsigned int TRANSFORM_SQUARE_THRESHOLD = " << squareThreshold << ";\n"
+        << "};\n"
+        << "\n"
+        << "#endif\n";
+}
+
+int main(int argc, char* argv[])
+{
+    std::mt19937 generator(2024);
+    SizeType multiplyThreshold = FindMultiplyThreshold(generator, false, std::cerr);
+    SizeType squareThreshold = FindMultiplyThreshold(generator, true, std::cerr);
+    std::cerr << "TRANSFORM_MULTIPLY_THRESHOLD = " << multiplyThreshold << '\n'
+        << "TRANSFORM_SQUARE_THRESHOLD = " << squareThreshold << '\n';
+    if (argc > 1)
+    {
+        std::ofstream out(argv[1]);
+        if (!out)
+        {
+            std::cerr << "Can not write " << argv[1] << '\n';
+            return 1;
+        }
+        WriteHeader(out, multiplyThreshold, squareThreshold);
+        return 0;
+    }
+    WriteHeader(std::cout, multiplyThreshold, squareThreshold);
+    return 0;
+}